@@ -58,6 +58,29 @@ TEST_F(JobSystemTest, BasicFunctionality)
     EXPECT_EQ(counter, taskCount);
 }
 
+// the JobSystem accepts jobs again after join(), so parallelFor() is not run serially on the calling thread
+TEST_F(JobSystemTest, ParallelForAfterJoin)
+{
+    auto js = std::make_unique<ec2s::JobSystem>(4);
+    js->join();
+
+    const auto caller = std::this_thread::get_id();
+    std::atomic<int> otherThreadRangeNum{ 0 };
+    std::atomic<std::size_t> total{ 0 };
+    js->parallelFor(64, 1,
+                    [&](const std::size_t begin, const std::size_t end)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        otherThreadRangeNum += (std::this_thread::get_id() != caller);
+                        total += end - begin;
+                    });
+
+    EXPECT_EQ(total, 64);
+    EXPECT_GT(otherThreadRangeNum, 0);
+
+    js->stop();
+}
+
 TEST_F(JobSystemTest, ParallelExecutionCorrectness)
 {
     std::vector<int> results(1000, 0);
@@ -131,6 +154,106 @@ TEST_F(JobSystemTest, ECSIntegration)
     EXPECT_TRUE(allCorrect);
 }
 
+// the same View type iterated concurrently (per-task Registries and one shared Registry)
+TEST_F(JobSystemTest, ConcurrentView)
+{
+    const int taskCount         = 32;
+    const std::size_t entityNum = 2000;
+
+    // fixed number of workers so that the tasks overlap regardless of the environment
+    auto js = std::make_unique<ec2s::JobSystem>(4);
+
+    ec2s::Registry shared;
+    for (std::size_t i = 0; i < entityNum; ++i)
+    {
+        auto entity = shared.create();
+        shared.add<int>(entity, static_cast<int>(i));
+        if (i % 3 == 0)
+        {
+            shared.add<double>(entity, static_cast<double>(i));
+        }
+    }
+
+    std::atomic<int> failed{ 0 };
+    for (int task = 0; task < taskCount; ++task)
+    {
+        js->exec(
+            [&shared, &failed, task, entityNum]()
+            {
+                // per-task Registry, whose entities differ in which of them have both Components
+                ec2s::Registry registry;
+                std::size_t expected = 0;
+                for (std::size_t i = 0; i < entityNum; ++i)
+                {
+                    auto entity = registry.create();
+                    registry.add<int>(entity, task);
+                    if ((i + task) % 2 == 0)
+                    {
+                        registry.add<double>(entity, static_cast<double>(task));
+                        ++expected;
+                    }
+                }
+
+                std::size_t count = 0;
+                registry.view<int, double>().each(
+                    [&](int& i, double& d)
+                    {
+                        failed += (i != task || d != static_cast<double>(task));
+                        ++count;
+                    });
+                failed += (count != expected);
+
+                // read-only iteration of the shared Registry
+                shared.view<int, double>().each([&](ec2s::Entity, const int& i, const double& d) { failed += (static_cast<double>(i) != d); });
+            });
+    }
+
+    js->stop();
+    EXPECT_EQ(failed, 0);
+}
+
+// parallel each over SparseSet, View and Registry
+TEST_F(JobSystemTest, ParallelEach)
+{
+    const std::size_t entityNum = 100000;
+    auto js                     = std::make_unique<ec2s::JobSystem>(4);
+
+    ec2s::Registry registry;
+    for (std::size_t i = 0; i < entityNum; ++i)
+    {
+        auto entity = registry.create();
+        registry.add<int>(entity, 1);
+        if (i % 2 == 0)
+        {
+            registry.add<double>(entity, static_cast<double>(i));
+        }
+    }
+
+    registry.parallelEach<int>(*js, [](int& i) { i += 1; }, 1000);
+
+    std::atomic<std::size_t> visited{ 0 };
+    registry.parallelEach<int, double>(
+        *js,
+        [&visited](ec2s::Entity, int& i, double& d)
+        {
+            d += i;
+            ++visited;
+        });
+    EXPECT_EQ(visited, entityNum / 2);
+
+    std::atomic<std::size_t> sum{ 0 };
+    registry.view<double>().parallelEach(*js, [&sum](double& d) { sum += static_cast<std::size_t>(d); }, 777);
+    EXPECT_EQ(sum, entityNum / 2 * (entityNum - 2) / 2 + entityNum);
+
+    // grain size larger than the pool and an empty pool
+    std::atomic<int> failed{ 0 };
+    registry.parallelEach<int>(*js, [&failed](ec2s::Entity, const int& i) { failed += (i != 2); }, entityNum * 2);
+    registry.parallelEach<char>(*js, [&failed](char&) { ++failed; });
+    EXPECT_EQ(failed, 0);
+
+    js->stop();
+}
+
 // check performance
 TEST_F(JobSystemTest, PerformanceBenchmark)
 {
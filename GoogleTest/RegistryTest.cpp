@@ -8,6 +8,7 @@
 
 #include <gtest/gtest.h>
 #include "../include/EC2S.hpp"
+#include <algorithm>
 
 // component structures for testing
 struct TestCompA
@@ -212,4 +213,1131 @@ TEST_F(RegistryTest, ComponentDeletion)
     // delete individual components
     registry.remove<TestCompB>(entity);
     EXPECT_EQ(registry.size<TestCompB>(), 0);
-}
\ No newline at end of file
+}
+
+// component stored in pointer-stable pages
+struct TestStableComp
+{
+    TestStableComp(int v)
+        : value(v)
+    {
+    }
+    int value;
+};
+
+template <>
+struct ec2s::Traits::ComponentTraits<TestStableComp> : public ec2s::Traits::DefaultComponentTraits
+{
+    static constexpr std::size_t kPageSize = 64;
+};
+
+// paged storage tests
+TEST_F(RegistryTest, PagedStoragePointerStability)
+{
+    auto first = registry.create();
+    registry.add<TestStableComp>(first, 7);
+    const TestStableComp* pFirst = &registry.get<TestStableComp>(first);
+
+    // growth over many pages never relocates existing components
+    for (int i = 0; i < 1000; ++i)
+    {
+        registry.add<TestStableComp>(registry.create(), i);
+    }
+
+    EXPECT_EQ(pFirst, &registry.get<TestStableComp>(first));
+    EXPECT_EQ(pFirst->value, 7);
+    EXPECT_EQ(registry.size<TestStableComp>(), 1001);
+
+    int sum = 0;
+    registry.each<TestStableComp>([&sum](TestStableComp& c) { sum += c.value; });
+    EXPECT_EQ(sum, 7 + 999 * 1000 / 2);
+}
+
+// tag component without any data
+struct TestTagComp
+{
+};
+
+// empty component whose constructor is observable (must not be routed to EmptyStorage)
+struct TestCountedEmptyComp
+{
+    inline static int constructedNum = 0;
+
+    TestCountedEmptyComp()
+    {
+        ++constructedNum;
+    }
+};
+
+// empty component tests
+TEST_F(RegistryTest, EmptyTagComponent)
+{
+    static_assert(std::is_same_v<ec2s::SparseSet<TestTagComp>::Storage, ec2s::EmptyStorage<TestTagComp>>);
+    static_assert(!std::is_same_v<ec2s::SparseSet<TestCountedEmptyComp>::Storage, ec2s::EmptyStorage<TestCountedEmptyComp>>);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto entity = registry.create();
+        registry.add<TestCompA>(entity, i);
+        if (i % 4 == 0)
+        {
+            registry.add<TestTagComp>(entity);
+        }
+    }
+
+    EXPECT_EQ(registry.size<TestTagComp>(), 25);
+    EXPECT_TRUE(registry.contains<TestTagComp>(0));
+    EXPECT_FALSE(registry.contains<TestTagComp>(1));
+
+    int sum = 0;
+    registry.view<TestCompA, TestTagComp>().each([&sum](TestCompA& a, TestTagComp&) { sum += a.value; });
+    EXPECT_EQ(sum, 4 * (24 * 25 / 2));
+
+    registry.remove<TestTagComp>(0);
+    EXPECT_FALSE(registry.contains<TestTagComp>(0));
+    EXPECT_EQ(registry.size<TestTagComp>(), 24);
+
+    TestCountedEmptyComp::constructedNum = 0;
+    const auto entity                    = registry.create();
+    registry.add<TestCountedEmptyComp>(entity);
+    EXPECT_EQ(TestCountedEmptyComp::constructedNum, 1);
+    EXPECT_TRUE(registry.contains<TestCountedEmptyComp>(entity));
+}
+
+// owning group tests
+TEST_F(RegistryTest, OwningGroup)
+{
+    std::vector<ec2s::Entity> entities;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto entity = registry.create();
+        entities.push_back(entity);
+        registry.add<TestCompA>(entity, i);
+        if (i % 2 == 0)
+        {
+            registry.add<TestCompB>(entity, static_cast<double>(i));
+        }
+    }
+
+    // entities created before the declaration are collected
+    auto& group = registry.group<TestCompA, TestCompB>();
+    EXPECT_EQ(group.size(), 50);
+    EXPECT_EQ(&group, &(registry.group<TestCompA, TestCompB>()));
+
+    // add / remove / destroy maintain the prefix
+    registry.add<TestCompB>(entities[1], 1.0);
+    registry.remove<TestCompB>(entities[0]);
+    registry.destroy(entities[2]);
+    registry.remove<TestCompA>(entities[4]);
+    EXPECT_EQ(group.size(), 48);
+
+    std::size_t count = 0;
+    group.each(
+        [&](const ec2s::Entity entity, TestCompA& a, TestCompB& b)
+        {
+            EXPECT_EQ(static_cast<double>(a.value), b.value);
+            EXPECT_EQ(registry.get<TestCompA>(entity).value, a.value);
+            ++count;
+        });
+    EXPECT_EQ(count, group.size());
+
+    // the prefix is exactly the set of entities having both components
+    std::size_t viewCount = 0;
+    registry.view<TestCompA, TestCompB>().each([&viewCount](TestCompA&, TestCompB&) { ++viewCount; });
+    EXPECT_EQ(viewCount, group.size());
+}
+
+// component stored as structure-of-arrays
+struct TestSoAComp
+{
+    TestSoAComp(float x, float v, int id)
+        : x(x)
+        , v(v)
+        , id(id)
+    {
+    }
+    float x;
+    float v;
+    int id;
+};
+
+template <>
+struct ec2s::Traits::ComponentTraits<TestSoAComp> : public ec2s::Traits::DefaultComponentTraits
+{
+    using Layout = ec2s::Traits::SoALayout<&TestSoAComp::x, &TestSoAComp::v, &TestSoAComp::id>;
+};
+
+// SoA storage tests
+TEST_F(RegistryTest, SoAStorage)
+{
+    std::vector<ec2s::Entity> entities;
+    for (int i = 0; i < 100; ++i)
+    {
+        entities.push_back(registry.create());
+        registry.add<TestSoAComp>(entities.back(), static_cast<float>(i), 2.f, i);
+    }
+
+    registry.eachFields<TestSoAComp>(
+        [](std::span<float> xs, std::span<float> vs, std::span<int> ids)
+        {
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(xs.data()) % 64, 0);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(vs.data()) % 64, 0);
+            EXPECT_EQ(xs.size(), 100);
+            EXPECT_EQ(ids.size(), 100);
+            for (std::size_t i = 0; i < xs.size(); ++i)
+            {
+                xs[i] += vs[i];
+            }
+        });
+
+    registry.remove<TestSoAComp>(entities[10]);
+    EXPECT_EQ(registry.size<TestSoAComp>(), 99);
+
+    auto [x, v, id] = registry.get<TestSoAComp>(entities[99]);
+    EXPECT_EQ(x, 101.f);
+    EXPECT_EQ(id, 99);
+
+    // per-element access passes tuples of references to the data members
+    int count = 0;
+    registry.view<TestSoAComp, TestCompA>().each([&count](auto, TestCompA&) { ++count; });
+    EXPECT_EQ(count, 0);
+    registry.each<TestSoAComp>(
+        [](const ec2s::Entity entity, auto soa)
+        {
+            EXPECT_EQ(std::get<0>(soa), static_cast<float>(std::get<2>(soa) + 2));
+            EXPECT_EQ(std::get<2>(soa), static_cast<int>(entity));
+        });
+}
+
+// chunked iteration over an owning group
+TEST_F(RegistryTest, GroupEachChunk)
+{
+    auto& group = registry.group<TestCompA, TestCompB>();
+    for (int i = 0; i < 300; ++i)
+    {
+        auto entity = registry.create();
+        registry.add<TestCompA>(entity, i);
+        if (i % 3 == 0)
+        {
+            registry.add<TestCompB>(entity, 1.0);
+        }
+    }
+
+    std::size_t total = 0;
+    group.eachChunk(
+        [&total](std::span<TestCompA> as, std::span<TestCompB> bs)
+        {
+            EXPECT_EQ(as.size(), bs.size());
+            for (std::size_t i = 0; i < as.size(); ++i)
+            {
+                EXPECT_EQ(as[i].value % 3, 0);
+                bs[i].value += as[i].value;
+            }
+            total += as.size();
+        },
+        32);
+    EXPECT_EQ(total, 100);
+    EXPECT_EQ(registry.get<TestCompB>(9).value, 10.0);
+
+    // a const Group hands out const spans and elements (reads never stamp the changed ticks)
+    const auto& constGroup = group;
+    total                  = 0;
+    constGroup.eachChunk([&total](std::span<const TestCompA> as, std::span<const TestCompB>) { total += as.size(); }, 32);
+    constGroup.each([&total](ec2s::Entity entity, const TestCompA& a, const TestCompB& b) { total += (static_cast<int>(entity) == a.value && b.value == a.value + 1.0) ? 1 : 0; });
+    EXPECT_EQ(total, 200);
+}
+
+// bulk insertion tests
+TEST_F(RegistryTest, BulkInsert)
+{
+    std::vector<ec2s::Entity> entities(100);
+    for (auto& e : entities)
+    {
+        e = registry.create();
+    }
+
+    // the owning Group and the listeners are notified after each batch is appended
+    auto& group = registry.group<TestCompA, TestCompB>();
+    ec2s::Observer observer(registry);
+    observer.observeConstruct<TestCompB>();
+
+    registry.insert<TestCompA>(entities.begin(), entities.end(), TestCompA(5));
+    EXPECT_EQ(registry.size<TestCompA>(), 100);
+    EXPECT_EQ(registry.get<TestCompA>(entities[42]).value, 5);
+
+    std::vector<TestCompB> values;
+    for (std::size_t i = 0; i < 50; ++i)
+    {
+        values.emplace_back(static_cast<double>(i));
+    }
+    registry.insert<TestCompB>(entities.begin() + 50, entities.end(), values.begin());
+    EXPECT_EQ(registry.size<TestCompB>(), 50);
+    EXPECT_EQ(registry.get<TestCompB>(entities[60]).value, 10.0);
+    EXPECT_FALSE(registry.contains<TestCompB>(entities[49]));
+    EXPECT_EQ(group.size(), 50);
+    EXPECT_EQ(observer.size(), 50);
+    EXPECT_TRUE(observer.contains(entities[99]));
+
+    // Entities which already have the Component are replaced
+    registry.insert<TestCompB>(entities.begin() + 90, entities.end(), TestCompB(-1.0));
+    EXPECT_EQ(registry.size<TestCompB>(), 50);
+    EXPECT_EQ(registry.get<TestCompB>(entities[95]).value, -1.0);
+    EXPECT_EQ(group.size(), 50);
+
+    std::size_t count = 0;
+    registry.view<TestCompA, TestCompB>().each([&count](TestCompA&, TestCompB&) { ++count; });
+    EXPECT_EQ(count, 50);
+
+    // notifications follow the order of application even if an Entity appears twice in one batch
+    std::vector<std::pair<char, ec2s::Entity>> notified;
+    registry.onConstruct<TestCompC>().connect(&notified, [](void* const pInstance, const ec2s::Entity entity)
+                                              { static_cast<std::vector<std::pair<char, ec2s::Entity>>*>(pInstance)->emplace_back('c', entity); });
+    registry.onUpdate<TestCompC>().connect(&notified, [](void* const pInstance, const ec2s::Entity entity)
+                                           { static_cast<std::vector<std::pair<char, ec2s::Entity>>*>(pInstance)->emplace_back('u', entity); });
+
+    const std::vector<ec2s::Entity> batch = { entities[0], entities[1], entities[0] };
+    registry.insert<TestCompC>(batch.begin(), batch.end(), TestCompC('x'));
+    const std::vector<std::pair<char, ec2s::Entity>> expected = { { 'c', entities[0] }, { 'c', entities[1] }, { 'u', entities[0] } };
+    EXPECT_EQ(notified, expected);
+    EXPECT_EQ(registry.size<TestCompC>(), 2);
+}
+
+// batched destruction and removal tests
+TEST_F(RegistryTest, BatchDestroyAndRemove)
+{
+    auto& group = registry.group<TestCompA, TestCompB>();
+
+    std::vector<ec2s::Entity> entities;
+    for (int i = 0; i < 1000; ++i)
+    {
+        auto entity = registry.create();
+        entities.push_back(entity);
+        registry.add<TestCompA>(entity, i);
+        registry.add<TestCompC>(entity, 'c');
+        if (i % 2 == 0)
+        {
+            registry.add<TestCompB>(entity, static_cast<double>(i));
+        }
+    }
+
+    // onDestroy listeners see the victims still valid and holding the Component, as with single destroy
+    struct DestroyListener
+    {
+        ec2s::Registry* pRegistry;
+        int validNum;
+        int calledNum;
+    } listener{ &registry, 0, 0 };
+    registry.onDestroy<TestCompA>().connect(&listener,
+                                           [](void* const pInstance, const ec2s::Entity entity)
+                                           {
+                                               auto* const pListener = static_cast<DestroyListener*>(pInstance);
+                                               ++pListener->calledNum;
+                                               if (pListener->pRegistry->valid(entity) && pListener->pRegistry->contains<TestCompA>(entity) &&
+                                                   pListener->pRegistry->containsAll<TestCompA, TestCompC>(entity))
+                                               {
+                                                   ++pListener->validNum;
+                                               }
+                                           });
+
+    // destroy the first half (a duplicated handle is published and released once)
+    std::vector<ec2s::Entity> firstHalf(entities.begin(), entities.begin() + 500);
+    firstHalf.emplace_back(entities[0]);
+    registry.destroy(firstHalf.begin(), firstHalf.end());
+    EXPECT_EQ(listener.calledNum, 500);
+    EXPECT_EQ(listener.validNum, 500);
+    registry.onDestroy<TestCompA>().disconnect(&listener);
+    EXPECT_FALSE(registry.valid(entities[0]));
+    EXPECT_EQ(registry.size<TestCompA>(), 500);
+    EXPECT_EQ(registry.size<TestCompB>(), 250);
+    EXPECT_EQ(group.size(), 250);
+    EXPECT_EQ(registry.activeEntityNum(), 500);
+
+    // remove C from every third entity of the rest (including entities which do not have it)
+    std::vector<ec2s::Entity> victims;
+    for (std::size_t i = 0; i < 1000; i += 3)
+    {
+        victims.push_back(entities[i]);
+    }
+    registry.remove<TestCompC>(victims.begin(), victims.end());
+    EXPECT_EQ(registry.size<TestCompC>(), 500 - 167);
+
+    for (std::size_t i = 500; i < 1000; ++i)
+    {
+        EXPECT_EQ(registry.get<TestCompA>(entities[i]).value, static_cast<int>(i));
+        EXPECT_EQ(registry.contains<TestCompC>(entities[i]), i % 3 != 0);
+    }
+
+    group.each([](TestCompA& a, TestCompB& b) { EXPECT_EQ(static_cast<double>(a.value), b.value); });
+}
+
+// allocation through a user supplied memory resource tests
+TEST_F(RegistryTest, MemoryResource)
+{
+    // every allocation must come from the arena (the default resource and the arena upstream both throw)
+    std::vector<std::byte> buffer(1 << 22);
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    std::pmr::memory_resource* const pPrevResource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+
+    {
+        ec2s::Registry arenaRegistry(&arena);
+
+        std::vector<ec2s::Entity> entities(100);
+        for (auto& entity : entities)
+        {
+            entity = arenaRegistry.create();
+            arenaRegistry.add<TestCompA>(entity, 1);
+        }
+        arenaRegistry.insert<TestCompB>(entities.begin(), entities.end(), TestCompB(2.0));
+        arenaRegistry.destroy(entities.begin(), entities.begin() + 50);
+        arenaRegistry.add<TestCompC>(arenaRegistry.create(), 'c');
+
+        EXPECT_EQ(arenaRegistry.size<TestCompA>(), 50);
+        EXPECT_EQ(arenaRegistry.size<TestCompB>(), 50);
+
+        double sum = 0.0;
+        arenaRegistry.view<TestCompA, TestCompB>().each([&sum](TestCompA& a, TestCompB& b) { sum += a.value + b.value; });
+        EXPECT_EQ(sum, 150.0);
+
+        arenaRegistry.clear();
+    }
+
+    std::pmr::set_default_resource(pPrevResource);
+}
+
+// move-only and perfectly forwarded Component construction tests
+TEST_F(RegistryTest, MoveOnlyComponent)
+{
+    struct MoveOnly
+    {
+        MoveOnly(std::unique_ptr<int>&& p)
+            : ptr(std::move(p))
+        {
+        }
+        std::unique_ptr<int> ptr;
+    };
+
+    struct CopyCounter
+    {
+        CopyCounter(int& copies)
+            : pCopies(&copies)
+        {
+        }
+        CopyCounter(const CopyCounter& other)
+            : pCopies(other.pCopies)
+        {
+            ++*pCopies;
+        }
+        CopyCounter(CopyCounter&&) noexcept            = default;
+        CopyCounter& operator=(const CopyCounter&)     = default;
+        CopyCounter& operator=(CopyCounter&&) noexcept = default;
+        int* pCopies;
+    };
+
+    std::vector<ec2s::Entity> entities;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto entity = registry.create();
+        entities.push_back(entity);
+        registry.add<MoveOnly>(entity, std::make_unique<int>(i));
+    }
+
+    // removal moves the tail element into the hole
+    registry.remove<MoveOnly>(entities[10]);
+    registry.destroy(entities[20]);
+    EXPECT_EQ(registry.size<MoveOnly>(), 98);
+    EXPECT_EQ(*registry.get<MoveOnly>(entities[99]).ptr, 99);
+
+    // replacing an existing Component
+    registry.add<MoveOnly>(entities[0], std::make_unique<int>(-1));
+    EXPECT_EQ(*registry.get<MoveOnly>(entities[0]).ptr, -1);
+
+    int copies = 0;
+    for (std::size_t i = 0; i < 100; ++i)
+    {
+        registry.add<CopyCounter>(entities[i], CopyCounter(copies));
+    }
+    registry.remove<CopyCounter>(entities[0]);
+    EXPECT_EQ(copies, 0);
+}
+
+// per-Entity signature tests
+template <int N>
+struct ManyComp
+{
+    int value;
+};
+
+TEST_F(RegistryTest, Signature)
+{
+    auto e0 = registry.create();
+    auto e1 = registry.create();
+    registry.add<TestCompA>(e0, 1);
+    registry.add<TestCompB>(e0, 2.0);
+    registry.add<TestCompA>(e1, 3);
+
+    EXPECT_TRUE((registry.containsAll<TestCompA, TestCompB>(e0)));
+    EXPECT_FALSE((registry.containsAll<TestCompA, TestCompB>(e1)));
+    EXPECT_FALSE((registry.containsAll<TestCompA, TestCompC>(e0)));
+
+    registry.remove<TestCompB>(e0);
+    EXPECT_FALSE((registry.containsAll<TestCompA, TestCompB>(e0)));
+
+    // more Component types than one signature word
+    [&]<int... Ns>(std::integer_sequence<int, Ns...>) { (registry.add<ManyComp<Ns>>(e1, Ns), ...); }(std::make_integer_sequence<int, 100>());
+    registry.add<TestCompC>(e0, 'c');
+
+    EXPECT_TRUE((registry.containsAll<TestCompA, ManyComp<0>, ManyComp<70>, ManyComp<99>>(e1)));
+    EXPECT_TRUE((registry.containsAll<TestCompA, TestCompC>(e0)));
+    EXPECT_FALSE((registry.containsAll<ManyComp<70>>(e0)));
+
+    registry.destroy(e1);
+    EXPECT_EQ(registry.size<ManyComp<70>>(), 0);
+    EXPECT_EQ(registry.size<TestCompA>(), 1);
+    EXPECT_TRUE(registry.contains<TestCompC>(e0));
+
+    // a recycled Entity starts with an empty signature
+    auto e2 = registry.create();
+    EXPECT_FALSE((registry.containsAll<TestCompA>(e2)));
+    registry.add<ManyComp<99>>(e2, 0);
+
+    std::vector<ec2s::Entity> entities = { e0, e2 };
+    registry.destroy(entities.begin(), entities.end());
+    EXPECT_EQ(registry.size<TestCompA>(), 0);
+    EXPECT_EQ(registry.size<TestCompC>(), 0);
+    EXPECT_EQ(registry.size<ManyComp<99>>(), 0);
+}
+
+// versioned Entity recycling tests
+TEST_F(RegistryTest, EntityRecycling)
+{
+    auto first = registry.create();
+    registry.add<TestCompA>(first, 1);
+    EXPECT_TRUE(registry.valid(first));
+
+    // the same index is recycled with a new generation each time
+    std::vector<ec2s::Entity> handles = { first };
+    for (int i = 0; i < 3; ++i)
+    {
+        registry.destroy(handles.back());
+        EXPECT_FALSE(registry.valid(handles.back()));
+
+        auto recycled = registry.create();
+        EXPECT_EQ(recycled & ec2s::kEntityIndexMask, first & ec2s::kEntityIndexMask);
+        for (const auto stale : handles)
+        {
+            EXPECT_NE(recycled, stale);
+            EXPECT_FALSE(registry.valid(stale));
+            EXPECT_FALSE(registry.contains<TestCompA>(stale));
+        }
+        registry.add<TestCompA>(recycled, i);
+        handles.push_back(recycled);
+    }
+
+    // destroying a stale handle does not affect the Entity now in the slot
+    registry.destroy(first);
+    EXPECT_TRUE(registry.valid(handles.back()));
+    EXPECT_TRUE(registry.contains<TestCompA>(handles.back()));
+    EXPECT_EQ(registry.activeEntityNum(), 1);
+
+    std::vector<ec2s::Entity> batch = { handles.back(), first, handles.back() };
+    registry.destroy(batch.begin(), batch.end());
+    EXPECT_EQ(registry.activeEntityNum(), 0);
+    EXPECT_EQ(registry.size<TestCompA>(), 0);
+
+    // clear invalidates every handle
+    auto alive = registry.create();
+    registry.clear();
+    EXPECT_FALSE(registry.valid(alive));
+    EXPECT_EQ(registry.activeEntityNum(), 0);
+}
+
+// dense Component type index tests
+TEST_F(RegistryTest, TypeIndex)
+{
+    const std::size_t indexA = ec2s::TypeHasher::index<TestCompA>();
+    const std::size_t indexB = ec2s::TypeHasher::index<TestCompB>();
+    EXPECT_NE(indexA, indexB);
+    EXPECT_EQ(indexA, ec2s::TypeHasher::index<TestCompA>());
+
+    // Registries adding types in different orders share the same indices
+    ec2s::Registry other;
+    auto e0 = other.create();
+    other.add<TestCompB>(e0, 1.0);
+    other.add<TestCompA>(e0, 2);
+
+    auto e1 = registry.create();
+    registry.add<TestCompA>(e1, 3);
+
+    EXPECT_EQ(other.get<TestCompA>(e0).value, 2);
+    EXPECT_EQ(other.get<TestCompB>(e0).value, 1.0);
+    EXPECT_EQ(registry.get<TestCompA>(e1).value, 3);
+    EXPECT_ANY_THROW(registry.get<TestCompB>(e1));
+    EXPECT_EQ(registry.size<TestCompB>(), 0);
+}
+
+// View iterator tests
+TEST_F(RegistryTest, ViewIterator)
+{
+    static_assert(std::ranges::forward_range<ec2s::View<TestCompA, TestCompB>>);
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto entity = registry.create();
+        registry.add<TestCompA>(entity, i);
+        if (i % 4 == 0)
+        {
+            registry.add<TestCompB>(entity, static_cast<double>(i));
+        }
+    }
+
+    std::size_t count = 0;
+    for (auto [entity, a, b] : registry.view<TestCompA, TestCompB>())
+    {
+        EXPECT_EQ(static_cast<double>(a.value), b.value);
+        EXPECT_TRUE(registry.contains<TestCompB>(entity));
+        a.value = -1;
+        ++count;
+    }
+    EXPECT_EQ(count, 25);
+    EXPECT_EQ(registry.get<TestCompA>(0).value, -1);
+    EXPECT_EQ(registry.get<TestCompA>(1).value, 1);
+
+    // early-exit search over a temporary View
+    auto found = std::ranges::find_if(registry.view<TestCompA, TestCompB>(), [](const auto& tuple) { return std::get<2>(tuple).value == 40.0; });
+    ASSERT_NE(found, (registry.view<TestCompA, TestCompB>().end()));
+    EXPECT_EQ(std::get<0>(*found), 40);
+
+    // single Component View
+    EXPECT_EQ(std::ranges::distance(registry.view<TestCompA>()), 100);
+
+    // a C++20 forward iterator, but only a legacy input iterator because of the proxy reference (writes go through the proxy tuple)
+    using ViewIterator = ec2s::View<TestCompA, TestCompB>::Iterator;
+    static_assert(std::forward_iterator<ViewIterator>);
+    static_assert(std::is_same_v<std::iterator_traits<ViewIterator>::iterator_category, std::input_iterator_tag>);
+    auto view = registry.view<TestCompA, TestCompB>();
+    std::ranges::for_each(view, [](auto tuple) { std::get<1>(tuple).value = static_cast<int>(std::get<2>(tuple).value) * 2; });
+    EXPECT_EQ(registry.get<TestCompA>(40).value, 80);
+    EXPECT_EQ(registry.get<TestCompA>(41).value, 41);
+    EXPECT_EQ(std::ranges::count_if(view, [](const auto& tuple) { return std::get<1>(tuple).value % 8 != 0; }), 0);
+}
+
+// View exclusion tests
+TEST_F(RegistryTest, ViewExclude)
+{
+    struct Frozen
+    {
+    };
+    struct Burning
+    {
+        int value;
+    };
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto entity = registry.create();
+        registry.add<TestCompA>(entity, i);
+        registry.add<TestCompB>(entity, static_cast<double>(i));
+        if (i % 3 == 0)
+        {
+            registry.add<Frozen>(entity);
+        }
+        if (i % 5 == 0)
+        {
+            registry.add<TestCompC>(entity, 'c');
+        }
+    }
+
+    std::size_t count = 0;
+    registry.view<TestCompA, TestCompB>(ec2s::exclude<Frozen>).each(
+        [&](ec2s::Entity entity, TestCompA& a, TestCompB&)
+        {
+            EXPECT_NE(a.value % 3, 0);
+            EXPECT_FALSE(registry.contains<Frozen>(entity));
+            ++count;
+        });
+    EXPECT_EQ(count, 66);
+
+    // multiple excluded types, through the iterator
+    count = 0;
+    for (auto [entity, a] : registry.view<TestCompA>(ec2s::exclude<Frozen, TestCompC>))
+    {
+        EXPECT_TRUE(a.value % 3 != 0 && a.value % 5 != 0);
+        ++count;
+    }
+    EXPECT_EQ(count, 53);
+
+    // excluded type which has never been added
+    count = 0;
+    registry.view<TestCompA>(ec2s::exclude<Burning>).each([&](TestCompA&) { ++count; });
+    EXPECT_EQ(count, 100);
+}
+
+// View optional Component tests
+TEST_F(RegistryTest, ViewOptional)
+{
+    for (int i = 0; i < 100; ++i)
+    {
+        auto entity = registry.create();
+        registry.add<TestCompA>(entity, i);
+        if (i % 4 == 0)
+        {
+            registry.add<TestCompC>(entity, 'c');
+        }
+    }
+
+    // the smaller optional pool must not become the pivot
+    std::size_t count = 0, present = 0;
+    registry.view<ec2s::Optional<TestCompC>, TestCompA>().each(
+        [&](ec2s::Entity entity, TestCompC* pC, TestCompA& a)
+        {
+            EXPECT_EQ(pC != nullptr, a.value % 4 == 0);
+            EXPECT_EQ(pC != nullptr, registry.contains<TestCompC>(entity));
+            if (pC)
+            {
+                EXPECT_EQ(pC->value, 'c');
+                ++present;
+            }
+            ++count;
+        });
+    EXPECT_EQ(count, 100);
+    EXPECT_EQ(present, 25);
+    EXPECT_EQ((registry.view<TestCompA, ec2s::Optional<TestCompC>>().getMinSize()), 100);
+
+    // through the iterator, writing via the pointer
+    for (auto [entity, a, pC] : registry.view<TestCompA, ec2s::Optional<TestCompC>>())
+    {
+        if (pC)
+        {
+            pC->value = 'd';
+        }
+    }
+    registry.each<TestCompC>([](TestCompC& c) { EXPECT_EQ(c.value, 'd'); });
+
+    // optional type which has never been added
+    count = 0;
+    registry.view<TestCompA, ec2s::Optional<TestCompB>>().each<ec2s::Optional<TestCompB>>(
+        [&](TestCompB* pB)
+        {
+            EXPECT_EQ(pB, nullptr);
+            ++count;
+        });
+    EXPECT_EQ(count, 100);
+}
+
+// runtime query tests
+TEST_F(RegistryTest, RuntimeView)
+{
+    struct Tag
+    {
+    };
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto entity = registry.create();
+        registry.add<TestCompA>(entity, i);
+        if (i % 2 == 0)
+        {
+            registry.add<TestCompB>(entity, static_cast<double>(i));
+        }
+        if (i % 4 == 0)
+        {
+            registry.add<Tag>(entity);
+        }
+        if (i % 5 == 0)
+        {
+            registry.add<TestCompC>(entity, 'c');
+        }
+    }
+
+    const ec2s::TypeHash included[] = { ec2s::TypeHasher::hash<TestCompA>(), ec2s::TypeHasher::hash<TestCompB>(), ec2s::TypeHasher::hash<Tag>() };
+    const ec2s::TypeHash excluded[] = { ec2s::TypeHasher::hash<TestCompC>() };
+
+    auto view = registry.runtimeView(included, excluded);
+    EXPECT_EQ(view.getMinSize(), 25);
+
+    std::size_t count = 0;
+    view.each(
+        [&](ec2s::Entity entity, const ec2s::RuntimeView::RawComponents& components)
+        {
+            ASSERT_EQ(components.size(), 3);
+            EXPECT_EQ(components.getStride(0), sizeof(TestCompA));
+            EXPECT_EQ(components.getStride(2), 0);
+            EXPECT_EQ(components[2], nullptr);
+            EXPECT_EQ(components[0], &registry.get<TestCompA>(entity));
+
+            const auto& a = components.get<const TestCompA>(0);
+            EXPECT_EQ(&components.get<TestCompA>(0), &a);
+            EXPECT_EQ(a.value % 4, 0);
+            EXPECT_NE(a.value % 5, 0);
+            EXPECT_EQ(static_cast<const TestCompB*>(components[1])->value, static_cast<double>(a.value));
+            EXPECT_TRUE(view.contains(entity));
+            ++count;
+        });
+    EXPECT_EQ(count, 20);
+
+    // included type which has never been added
+    const ec2s::TypeHash unknown[] = { ec2s::TypeHasher::hash<TestCompA>(), ec2s::TypeHasher::hash<TestStableComp>() };
+    auto empty = registry.runtimeView(unknown);
+    EXPECT_EQ(empty.getMinSize(), 0);
+    empty.each([](ec2s::Entity, const ec2s::RuntimeView::RawComponents&) { FAIL(); });
+}
+
+// components whose SparseSets maintain a membership bitset
+template <int N>
+struct IndexedComp
+{
+    IndexedComp(int v)
+        : value(v)
+    {
+    }
+    int value;
+};
+
+template <int N>
+struct ec2s::Traits::ComponentTraits<IndexedComp<N>> : public ec2s::Traits::DefaultComponentTraits
+{
+    static constexpr bool kMembershipBitset = true;
+};
+
+// membership bitset tests
+TEST_F(RegistryTest, MembershipBitset)
+{
+    // sparse overlap spread over many 4096-entity blocks
+    std::vector<ec2s::Entity> entities;
+    for (int i = 0; i < 20000; ++i)
+    {
+        auto entity = registry.create();
+        entities.emplace_back(entity);
+        if (i % 2 == 0)
+        {
+            registry.add<IndexedComp<0>>(entity, i);
+        }
+        if (i % 3 == 0)
+        {
+            registry.add<IndexedComp<1>>(entity, i);
+        }
+        if (i % 5 == 0)
+        {
+            registry.add<IndexedComp<2>>(entity, i);
+        }
+        if (i % 7 == 0)
+        {
+            registry.add<IndexedComp<3>>(entity, i);
+        }
+    }
+
+    auto countMatches = [&]()
+    {
+        std::size_t count = 0;
+        int last          = -1;
+        registry.view<IndexedComp<0>, IndexedComp<1>, IndexedComp<2>, IndexedComp<3>>().each(
+            [&](ec2s::Entity entity, IndexedComp<0>& a, IndexedComp<1>& b, IndexedComp<2>&, IndexedComp<3>&)
+            {
+                EXPECT_EQ(a.value % 210, 0);
+                EXPECT_EQ(a.value, b.value);
+                EXPECT_LT(last, a.value);
+                EXPECT_TRUE((registry.containsAll<IndexedComp<0>, IndexedComp<1>, IndexedComp<2>, IndexedComp<3>>(entity)));
+                last = a.value;
+                ++count;
+            });
+        return count;
+    };
+    EXPECT_EQ(countMatches(), 96);
+
+    // removal, destruction and recycled indices keep the bitsets in sync
+    registry.remove<IndexedComp<2>>(entities[0]);
+    registry.destroy(entities[210]);
+    auto recycled = registry.create();
+    registry.add<IndexedComp<0>>(recycled, 210);
+    EXPECT_EQ(countMatches(), 94);
+
+    // excluded pool with a bitset, and an optional one
+    std::size_t count = 0;
+    registry.view<IndexedComp<0>, IndexedComp<1>, ec2s::Optional<TestCompA>>(ec2s::exclude<IndexedComp<3>>).each(
+        [&](IndexedComp<0>& a, IndexedComp<1>&, TestCompA* pA)
+        {
+            EXPECT_NE(a.value % 7, 0);
+            EXPECT_EQ(pA, nullptr);
+            ++count;
+        });
+    EXPECT_EQ(count, 2857);
+
+    registry.clear();
+    EXPECT_EQ(countMatches(), 0);
+}
+
+// signal and observer tests
+TEST_F(RegistryTest, Observer)
+{
+    std::vector<ec2s::Entity> entities;
+    for (int i = 0; i < 10; ++i)
+    {
+        auto entity = registry.create();
+        registry.add<TestCompA>(entity, i);
+        entities.emplace_back(entity);
+    }
+
+    ec2s::Observer observer(registry);
+    observer.observeConstruct<TestCompB>().observeUpdate<TestCompA>();
+    EXPECT_TRUE(observer.empty());
+
+    // several events on the same entity are collected once
+    registry.patch<TestCompA>(entities[1], [](TestCompA& a) { a.value += 100; });
+    registry.patch<TestCompA>(entities[1], [](TestCompA& a) { a.value += 100; });
+    registry.add<TestCompB>(entities[1], 1.0);
+    registry.add<TestCompA>(entities[3], 30);
+    registry.add<TestCompB>(entities[5], 5.0);
+    EXPECT_EQ(registry.get<TestCompA>(entities[1]).value, 201);
+    EXPECT_EQ(observer.size(), 3);
+    EXPECT_TRUE(observer.contains(entities[3]));
+
+    std::vector<ec2s::Entity> drained;
+    observer.each([&](ec2s::Entity entity) { drained.emplace_back(entity); });
+    EXPECT_EQ(drained, (std::vector<ec2s::Entity>{ entities[1], entities[3], entities[5] }));
+    EXPECT_TRUE(observer.empty());
+
+    // events on unobserved types are ignored
+    registry.patch<TestCompB>(entities[1], [](TestCompB& b) { b.value = 2.0; });
+    EXPECT_TRUE(observer.empty());
+
+    // destroy signal is published before the Component is removed
+    int destroyed = 0;
+    auto onDestroy = [](void* const pInstance, const ec2s::Entity) { ++*static_cast<int*>(pInstance); };
+    registry.onDestroy<TestCompA>().connect(&destroyed, onDestroy);
+    registry.destroy(entities[0]);
+    registry.destroy(entities.begin() + 6, entities.end());
+    EXPECT_EQ(destroyed, 5);
+    registry.onDestroy<TestCompA>().disconnect(&destroyed);
+    registry.clear();
+    EXPECT_EQ(destroyed, 5);
+
+    // a handle destroyed and recycled before the drain is replaced by the new one (keyed by the entity index)
+    const auto stale = registry.create();
+    registry.add<TestCompB>(stale, 1.0);
+    registry.destroy(stale);
+    const auto recycled = registry.create();
+    EXPECT_EQ(recycled & ec2s::kEntityIndexMask, stale & ec2s::kEntityIndexMask);
+    registry.add<TestCompB>(recycled, 2.0);
+    EXPECT_EQ(observer.size(), 1);
+    EXPECT_FALSE(observer.contains(stale));
+    EXPECT_TRUE(observer.contains(recycled));
+    EXPECT_EQ(observer.getEntities().front(), recycled);
+
+    // the filter is checked against the Components at drain time
+    const auto required = registry.create();
+    registry.add<TestCompB>(required, 3.0);
+    registry.add<TestCompA>(required, 3);
+    const auto excluded = registry.create();
+    registry.add<TestCompB>(excluded, 4.0);
+    registry.add<TestCompA>(excluded, 4);
+    registry.add<TestCompC>(excluded, 'c');
+    EXPECT_EQ(observer.size(), 3);
+
+    drained.clear();
+    observer.where<TestCompA>().exclude<TestCompC>().each([&](ec2s::Entity entity) { drained.emplace_back(entity); });
+    EXPECT_EQ(drained, (std::vector<ec2s::Entity>{ required }));
+    EXPECT_TRUE(observer.empty());
+
+    // disconnected observers collect nothing
+    observer.disconnect();
+    auto entity = registry.create();
+    registry.add<TestCompB>(entity, 1.0);
+    EXPECT_TRUE(observer.empty());
+}
+
+// listeners connecting and disconnecting while being published
+TEST_F(RegistryTest, SignalReentrancy)
+{
+    struct Listener
+    {
+        ec2s::Signal* pSignal;
+        int calledNum;
+        int connectedCalledNum;
+    } listener{ &registry.onConstruct<TestCompA>(), 0, 0 };
+
+    // the first call disconnects itself and connects another listener (called from the next publish)
+    listener.pSignal->connect(&listener,
+                              [](void* const pInstance, const ec2s::Entity)
+                              {
+                                  auto* const pListener = static_cast<Listener*>(pInstance);
+                                  ++pListener->calledNum;
+                                  pListener->pSignal->disconnect(pListener);
+                                  for (int i = 0; i < 16; ++i)
+                                  {
+                                      pListener->pSignal->connect(&pListener->connectedCalledNum, [](void* const pCount, const ec2s::Entity) { ++*static_cast<int*>(pCount); });
+                                  }
+                              });
+
+    registry.add<TestCompA>(registry.create(), 0);
+    EXPECT_EQ(listener.calledNum, 1);
+    EXPECT_EQ(listener.connectedCalledNum, 0);
+    EXPECT_FALSE(listener.pSignal->empty());
+
+    registry.add<TestCompA>(registry.create(), 1);
+    EXPECT_EQ(listener.calledNum, 1);
+    EXPECT_EQ(listener.connectedCalledNum, 16);
+
+    listener.pSignal->disconnect(&listener.connectedCalledNum);
+    EXPECT_TRUE(listener.pSignal->empty());
+}
+
+// component keeping change ticks
+struct TestTickedComp
+{
+    TestTickedComp(int v)
+        : value(v)
+    {
+    }
+    int value;
+};
+
+template <>
+struct ec2s::Traits::ComponentTraits<TestTickedComp> : public ec2s::Traits::DefaultComponentTraits
+{
+    static constexpr bool kChangeTicks = true;
+};
+
+// change tick tests
+TEST_F(RegistryTest, ChangeTicks)
+{
+    std::vector<ec2s::Entity> entities;
+    for (int i = 0; i < 100; ++i)
+    {
+        auto entity = registry.create();
+        registry.add<TestTickedComp>(entity, i);
+        registry.add<TestCompA>(entity, i);
+        entities.emplace_back(entity);
+    }
+
+    auto count = [](auto view) { return static_cast<std::size_t>(std::ranges::distance(view)); };
+
+    // a system which has never run sees everything
+    ec2s::Tick lastRun = 0;
+    EXPECT_EQ(count(registry.view<ec2s::Changed<TestTickedComp>>().since(lastRun)), 100);
+
+    // next run: only the stamped Components pass
+    lastRun = registry.advanceTick();
+    EXPECT_EQ(count(registry.view<ec2s::Changed<TestTickedComp>, TestCompA>().since(lastRun)), 0);
+
+    registry.get<TestTickedComp>(entities[3]).value = 300;
+    registry.patch<TestTickedComp>(entities[7], [](TestTickedComp& c) { c.value = 700; });
+    registry.remove<TestTickedComp>(entities[0]);  // swap-remove must carry the ticks of the moved element
+    auto added = registry.create();
+    registry.add<TestTickedComp>(added, 1000);
+
+    std::vector<int> values;
+    for (auto [entity, c, a] : registry.view<ec2s::Changed<TestTickedComp>, TestCompA>().since(lastRun))
+    {
+        values.emplace_back(c.value);
+    }
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<int>{ 300, 700 }));
+    EXPECT_EQ(count(registry.view<ec2s::Changed<TestTickedComp>>().since(lastRun)), 3);
+    EXPECT_EQ(count(registry.view<ec2s::Added<TestTickedComp>>().since(lastRun)), 1);
+
+    // mutable access through the SparseSet stamps the current tick, const access does not
+    ec2s::SparseSet<TestTickedComp> sparseSet;
+    sparseSet.emplace(entities[1], 1);
+    sparseSet.setCurrentTick(5);
+    EXPECT_EQ(std::as_const(sparseSet)[entities[1]].value, 1);
+    EXPECT_EQ(sparseSet.getChangedTick(entities[1]), 1);
+    sparseSet[entities[1]].value = 2;
+    EXPECT_EQ(sparseSet.getAddedTick(entities[1]), 1);
+    EXPECT_EQ(sparseSet.getChangedTick(entities[1]), 5);
+    sparseSet.setCurrentTick(6);
+    for (const TestTickedComp& c : std::as_const(sparseSet))
+    {
+        EXPECT_EQ(c.value, 2);
+    }
+    EXPECT_EQ(std::count_if(sparseSet.cbegin(), sparseSet.cend(), [](const TestTickedComp& c) { return c.value == 2; }), 1);
+    std::as_const(sparseSet).each([](const TestTickedComp& c) { EXPECT_EQ(c.value, 2); });
+    std::as_const(sparseSet).eachChunk([](std::span<const TestTickedComp> chunk) { EXPECT_EQ(chunk.size(), 1); });
+    EXPECT_EQ(std::as_const(sparseSet).getChunk(0, 1).front().value, 2);
+    EXPECT_EQ(sparseSet.getChangedTick(entities[1]), 5);
+    for (TestTickedComp& c : sparseSet)
+    {
+        c.value = 3;
+    }
+    EXPECT_EQ(sparseSet.getChangedTick(entities[1]), 6);
+
+    // sorting keeps the ticks with their elements
+    registry.sort<TestTickedComp>([](const TestTickedComp& l, const TestTickedComp& r) { return l.value > r.value; });
+    registry.view<ec2s::Changed<TestTickedComp>>().since(lastRun).each([](TestTickedComp& c) { EXPECT_TRUE(c.value == 300 || c.value == 700 || c.value == 1000); });
+
+    // reads through const access (const get, const View arguments) never stamp
+    lastRun = registry.advanceTick();
+    EXPECT_EQ(std::as_const(registry).get<TestTickedComp>(entities[5]).value, 5);
+    int sum = 0;
+    registry.view<const TestTickedComp, TestCompA>().each([&sum](const TestTickedComp& c, TestCompA&) { sum += c.value; });
+    for (auto [entity, c] : registry.view<ec2s::Changed<const TestTickedComp>>())
+    {
+        sum += c.value;
+    }
+    registry.each<const TestTickedComp>([&sum](const TestTickedComp& c) { sum += c.value; });
+    registry.each<const TestTickedComp>([&sum](ec2s::Entity, const TestTickedComp& c) { sum += c.value; });
+    registry.eachChunk<const TestTickedComp>([&sum](std::span<const TestTickedComp> chunk) { sum += static_cast<int>(chunk.size()); });
+    EXPECT_GT(sum, 0);
+    EXPECT_EQ(count(registry.view<ec2s::Changed<TestTickedComp>>().since(lastRun)), 0);
+
+    // so do reads through a RuntimeView, while get<T>() with a non-const T stamps
+    const ec2s::TypeHash ticked[] = { ec2s::TypeHasher::hash<TestTickedComp>() };
+    registry.runtimeView(ticked).each([&sum](ec2s::Entity, const ec2s::RuntimeView::RawComponents& components) { sum += components.get<const TestTickedComp>(0).value + static_cast<const TestTickedComp*>(components[0])->value; });
+    EXPECT_EQ(count(registry.view<ec2s::Changed<TestTickedComp>>().since(lastRun)), 0);
+    registry.runtimeView(ticked).each(
+        [&entities](ec2s::Entity entity, const ec2s::RuntimeView::RawComponents& components)
+        {
+            if (entity == entities[5])
+            {
+                components.get<TestTickedComp>(0).value += 1;
+            }
+        });
+    EXPECT_EQ(count(registry.view<ec2s::Changed<TestTickedComp>>().since(lastRun)), 1);
+    lastRun = registry.advanceTick();
+
+    // writes through Views (each() and the iterators) are detected
+    for (std::size_t i = 10; i < 20; ++i)
+    {
+        registry.add<TestCompB>(entities[i], 0.0);
+    }
+    registry.view<TestTickedComp, TestCompB>().each([](TestTickedComp& c, TestCompB&) { c.value += 1; });
+    EXPECT_EQ(count(registry.view<ec2s::Changed<TestTickedComp>>().since(lastRun)), 10);
+
+    lastRun = registry.advanceTick();
+    for (auto [entity, c, b] : registry.view<TestTickedComp, TestCompB>(ec2s::exclude<TestCompC>))
+    {
+        c.value += 1;
+    }
+    values.clear();
+    registry.view<ec2s::Changed<const TestTickedComp>>().since(lastRun).each([&values](const TestTickedComp& c) { values.emplace_back(c.value); });
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<int>{ 12, 13, 14, 15, 16, 17, 18, 19, 20, 21 }));
+
+    // so are writes through Registry::each()
+    lastRun = registry.advanceTick();
+    registry.each<TestTickedComp>([](TestTickedComp& c) { c.value += 1; });
+    EXPECT_EQ(count(registry.view<ec2s::Changed<TestTickedComp>>().since(lastRun)), registry.size<TestTickedComp>());
+
+    // a system advancing the tick at the end of each run sees writes made after it ran in the same frame, but not its own writes
+    ec2s::Tick systemLastRun = registry.advanceTick();
+    auto runSystem = [&registry = registry, &systemLastRun]()
+    {
+        std::vector<int> seen;
+        registry.view<ec2s::Changed<TestTickedComp>>().since(systemLastRun).each(
+            [&seen](TestTickedComp& c)
+            {
+                seen.emplace_back(c.value);
+                c.value = -c.value;
+            });
+        systemLastRun = registry.advanceTick();
+        return seen;
+    };
+
+    EXPECT_TRUE(runSystem().empty());
+    registry.patch<TestTickedComp>(entities[50], [](TestTickedComp& c) { c.value = 5000; });
+    registry.add<TestTickedComp>(entities[0], 0);
+    values = runSystem();
+    std::sort(values.begin(), values.end());
+    EXPECT_EQ(values, (std::vector<int>{ 0, 5000 }));
+    EXPECT_TRUE(runSystem().empty());
+    EXPECT_EQ(count(registry.view<ec2s::Added<TestTickedComp>>().since(systemLastRun)), 0);
+}
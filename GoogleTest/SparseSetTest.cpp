@@ -0,0 +1,360 @@
+/*****************************************************************//**
+ * @file   SparseSetTest.cpp
+ * @brief  Test codes for SparseSet
+ * 
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+
+#include <gtest/gtest.h>
+#include "../include/EC2S.hpp"
+#include <algorithm>
+#include <execution>
+
+// component structure for testing
+struct TestSSComp
+{
+    TestSSComp()
+        : value(0)
+    {
+    }
+    TestSSComp(int v)
+        : value(v)
+    {
+    }
+    int value;
+};
+
+class SparseSetTest : public ::testing::Test
+{
+protected:
+    ec2s::SparseSet<TestSSComp> sparseSet;
+};
+
+// sparse indices of distant entities
+TEST_F(SparseSetTest, DistantEntityIndex)
+{
+    const ec2s::Entity nearEntity = 3;
+    const ec2s::Entity farEntity  = 5000000;
+
+    sparseSet.emplace(nearEntity, 1);
+    sparseSet.emplace(farEntity, 2);
+
+    EXPECT_TRUE(sparseSet.contains(nearEntity));
+    EXPECT_TRUE(sparseSet.contains(farEntity));
+    EXPECT_FALSE(sparseSet.contains(farEntity - 1));
+    EXPECT_FALSE(sparseSet.contains(farEntity + ec2s::ISparseSet::kSparsePageSize));
+    EXPECT_EQ(sparseSet[nearEntity].value, 1);
+    EXPECT_EQ(sparseSet[farEntity].value, 2);
+
+    sparseSet.remove(farEntity);
+    EXPECT_FALSE(sparseSet.contains(farEntity));
+    EXPECT_TRUE(sparseSet.contains(nearEntity));
+    EXPECT_EQ(sparseSet[nearEntity].value, 1);
+    EXPECT_EQ(sparseSet.size(), 1);
+}
+
+// sorting by comparator
+TEST_F(SparseSetTest, SortByComparator)
+{
+    const int values[] = { 5, 3, 9, 1, 7, 2 };
+    for (ec2s::Entity e = 0; e < 6; ++e)
+    {
+        sparseSet.emplace(e, values[e]);
+    }
+
+    sparseSet.sort([](const TestSSComp& lhs, const TestSSComp& rhs) { return lhs.value < rhs.value; });
+
+    int prev = -1;
+    sparseSet.each(
+        [&prev](const ec2s::Entity, TestSSComp& c)
+        {
+            EXPECT_LT(prev, c.value);
+            prev = c.value;
+        });
+
+    // sparse indices follow the reordering
+    for (ec2s::Entity e = 0; e < 6; ++e)
+    {
+        EXPECT_EQ(sparseSet[e].value, values[e]);
+    }
+
+    sparseSet.sort([](const ec2s::Entity lhs, const ec2s::Entity rhs) { return lhs > rhs; });
+    EXPECT_EQ(sparseSet.getDenseEntities().front(), 5);
+    EXPECT_EQ(sparseSet.getDenseEntities().back(), 0);
+}
+
+// sorting to match another SparseSet
+TEST_F(SparseSetTest, SortAsOther)
+{
+    ec2s::SparseSet<double> other;
+    for (ec2s::Entity e = 0; e < 10; ++e)
+    {
+        sparseSet.emplace(e, static_cast<int>(e));
+        if (e % 2 == 0)
+        {
+            other.emplace(9 - e, 0.5);
+        }
+    }
+
+    sparseSet.sortAs(other);
+
+    // shared entities come first, in the other's order
+    const auto& dense = sparseSet.getDenseEntities();
+    for (std::size_t i = 0; i < other.size(); ++i)
+    {
+        EXPECT_EQ(dense[i], other.getDenseEntities()[i]);
+        EXPECT_EQ(sparseSet[dense[i]].value, static_cast<int>(dense[i]));
+    }
+
+    for (ec2s::Entity e = 0; e < 10; ++e)
+    {
+        EXPECT_TRUE(sparseSet.contains(e));
+        EXPECT_EQ(sparseSet[e].value, static_cast<int>(e));
+    }
+}
+
+// chunked iteration
+TEST_F(SparseSetTest, EachChunk)
+{
+    for (ec2s::Entity e = 0; e < 1000; ++e)
+    {
+        sparseSet.emplace(e, static_cast<int>(e));
+    }
+
+    std::size_t total = 0;
+    sparseSet.eachChunk(
+        [&total](std::span<const ec2s::Entity> entities, std::span<TestSSComp> chunk)
+        {
+            EXPECT_EQ(entities.size(), chunk.size());
+            EXPECT_LE(chunk.size(), 64);
+            EXPECT_EQ(total % 64, 0);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(chunk.data()) % ec2s::SparseSet<TestSSComp>::kPackedAlignment, 0);
+            for (std::size_t i = 0; i < chunk.size(); ++i)
+            {
+                EXPECT_EQ(chunk[i].value, static_cast<int>(entities[i]));
+                chunk[i].value *= 2;
+            }
+            total += chunk.size();
+        },
+        64);
+    EXPECT_EQ(total, 1000);
+    EXPECT_EQ(sparseSet[999].value, 1998);
+}
+
+// component stored in small pages
+struct TestSSPagedComp
+{
+    int value;
+};
+
+template <>
+struct ec2s::Traits::ComponentTraits<TestSSPagedComp> : public ec2s::Traits::DefaultComponentTraits
+{
+    static constexpr std::size_t kPageSize = 16;
+};
+
+// chunks never cross page boundaries
+TEST_F(SparseSetTest, EachChunkPaged)
+{
+    ec2s::SparseSet<TestSSPagedComp> paged;
+    for (ec2s::Entity e = 0; e < 100; ++e)
+    {
+        paged.emplace(e, TestSSPagedComp{ static_cast<int>(e) });
+    }
+
+    std::size_t total = 0;
+    paged.eachChunk(
+        [&total](std::span<TestSSPagedComp> chunk)
+        {
+            EXPECT_LE(chunk.size(), 16);
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(chunk.data()) % ec2s::SparseSet<TestSSPagedComp>::kPackedAlignment, 0);
+            for (std::size_t i = 0; i < chunk.size(); ++i)
+            {
+                EXPECT_EQ(chunk[i].value, static_cast<int>(total + i));
+            }
+            total += chunk.size();
+        });
+    EXPECT_EQ(total, 100);
+}
+
+// component removed in place
+struct TestSSInPlaceComp
+{
+    int value;
+};
+
+template <>
+struct ec2s::Traits::ComponentTraits<TestSSInPlaceComp> : public ec2s::Traits::DefaultComponentTraits
+{
+    static constexpr bool kInPlaceDelete = true;
+};
+
+// removal during iteration and deferred compaction
+TEST_F(SparseSetTest, InPlaceDelete)
+{
+    ec2s::SparseSet<TestSSInPlaceComp> inPlace;
+    for (ec2s::Entity e = 0; e < 100; ++e)
+    {
+        inPlace.emplace(e, TestSSInPlaceComp{ static_cast<int>(e) });
+    }
+
+    // removing (even other entities) while iterating keeps the iteration stable
+    int visited = 0;
+    inPlace.each(
+        [&](const ec2s::Entity entity, TestSSInPlaceComp& c)
+        {
+            EXPECT_EQ(c.value, static_cast<int>(entity));
+            ++visited;
+            if (entity % 2 == 0)
+            {
+                inPlace.remove(entity);
+                inPlace.remove(entity + 1);
+            }
+        });
+    EXPECT_EQ(visited, 50);
+    EXPECT_EQ(inPlace.size(), 0);
+    EXPECT_EQ(inPlace.getTombstoneNum(), 100);
+
+    for (ec2s::Entity e = 0; e < 10; ++e)
+    {
+        inPlace.emplace(e, TestSSInPlaceComp{ static_cast<int>(e) * 10 });
+    }
+    // adding compacted the tombstones automatically
+    EXPECT_EQ(inPlace.getTombstoneNum(), 0);
+    EXPECT_EQ(inPlace.getDenseEntities().size(), 10);
+
+    inPlace.remove(3);
+    inPlace.remove(7);
+    EXPECT_EQ(inPlace.size(), 8);
+    EXPECT_FALSE(inPlace.contains(3));
+
+    std::size_t chunked = 0;
+    inPlace.eachChunk(
+        [&chunked](std::span<const ec2s::Entity> entities, std::span<TestSSInPlaceComp> chunk)
+        {
+            for (std::size_t i = 0; i < chunk.size(); ++i)
+            {
+                EXPECT_NE(entities[i], ec2s::ISparseSet::kTombstoneEntity);
+                EXPECT_EQ(chunk[i].value, static_cast<int>(entities[i]) * 10);
+            }
+            chunked += chunk.size();
+        });
+    EXPECT_EQ(chunked, 8);
+
+    inPlace.compact();
+    EXPECT_EQ(inPlace.getDenseEntities().size(), 8);
+    for (ec2s::Entity e = 0; e < 10; ++e)
+    {
+        EXPECT_EQ(inPlace.contains(e), e != 3 && e != 7);
+        if (inPlace.contains(e))
+        {
+            EXPECT_EQ(inPlace[e].value, static_cast<int>(e) * 10);
+        }
+    }
+
+    // iterators skip the tombstones, and removing while iterating keeps them valid (nothing is compacted)
+    static_assert(std::bidirectional_iterator<ec2s::SparseSet<TestSSInPlaceComp>::Iterator>);
+    static_assert(!std::random_access_iterator<ec2s::SparseSet<TestSSInPlaceComp>::Iterator>);
+    inPlace.remove(4);
+    std::vector<ec2s::Entity> iterated;
+    for (auto itr = inPlace.begin(); itr != inPlace.end(); ++itr)
+    {
+        EXPECT_EQ((*itr).value, static_cast<int>(itr.entity()) * 10);
+        iterated.emplace_back(itr.entity());
+        if (itr.entity() == 0)
+        {
+            inPlace.remove(5);
+            inPlace.remove(6);
+        }
+    }
+    EXPECT_EQ(iterated, (std::vector<ec2s::Entity>{ 0, 1, 2, 8, 9 }));
+
+    // the dense Entities keep the tombstones until compaction
+    const auto& denseEntities = inPlace.getDenseEntities();
+    EXPECT_EQ(std::count(denseEntities.begin(), denseEntities.end(), ec2s::ISparseSet::kTombstoneEntity), 3);
+    EXPECT_EQ(inPlace.getTombstoneNum(), 3);
+
+    // adding while iterating defers the auto compaction, so the iteration order is kept
+    iterated.clear();
+    inPlace.each(
+        [&](const ec2s::Entity entity, TestSSInPlaceComp&)
+        {
+            iterated.emplace_back(entity);
+            if (entity == 0)
+            {
+                inPlace.emplace(20, TestSSInPlaceComp{ 200 });
+            }
+        });
+    EXPECT_EQ(iterated, (std::vector<ec2s::Entity>{ 0, 1, 2, 8, 9 }));
+    EXPECT_EQ(inPlace.getTombstoneNum(), 3);
+
+    inPlace.emplace(21, TestSSInPlaceComp{ 210 });
+    EXPECT_EQ(inPlace.getTombstoneNum(), 0);
+    EXPECT_EQ(inPlace.size(), 7);
+    EXPECT_EQ(inPlace[20].value, 200);
+}
+
+// relocation of a SparseSet stored in StackAny
+TEST_F(SparseSetTest, StackAnyMove)
+{
+    using Any = ec2s::StackAny<sizeof(ec2s::SparseSet<TestSSComp>)>;
+
+    Any from(std::in_place_type<ec2s::SparseSet<TestSSComp>>);
+    for (ec2s::Entity e = 0; e < 100; ++e)
+    {
+        from.get<ec2s::SparseSet<TestSSComp>>().emplace(e, static_cast<int>(e));
+    }
+
+    Any to(std::move(from));
+    EXPECT_FALSE(from.hasValue());
+    EXPECT_ANY_THROW(from.get<ec2s::SparseSet<TestSSComp>>());
+    EXPECT_EQ(to.get<ec2s::SparseSet<TestSSComp>>().size(), 100);
+    EXPECT_EQ(to.get<ec2s::SparseSet<TestSSComp>>()[42].value, 42);
+
+    Any assigned;
+    assigned = std::move(to);
+    EXPECT_FALSE(to.hasValue());
+    EXPECT_EQ(assigned.get<ec2s::SparseSet<TestSSComp>>()[99].value, 99);
+    EXPECT_ANY_THROW(assigned.get<ec2s::SparseSet<int>>());
+
+    assigned.reset();
+    EXPECT_FALSE(assigned.hasValue());
+}
+
+// iterators and std::ranges
+TEST_F(SparseSetTest, Iterator)
+{
+    static_assert(std::ranges::random_access_range<ec2s::SparseSet<TestSSComp>>);
+    static_assert(std::ranges::random_access_range<const ec2s::SparseSet<TestSSComp>>);
+    static_assert(std::is_convertible_v<ec2s::SparseSet<TestSSComp>::Iterator, ec2s::SparseSet<TestSSComp>::ConstIterator>);
+    static_assert(!std::is_convertible_v<ec2s::SparseSet<TestSSComp>::ConstIterator, ec2s::SparseSet<TestSSComp>::Iterator>);
+
+    for (ec2s::Entity e = 0; e < 1000; ++e)
+    {
+        sparseSet.emplace(e, static_cast<int>(e));
+    }
+    sparseSet.remove(10);
+
+    int sum = 0;
+    for (auto& comp : sparseSet)
+    {
+        sum += comp.value;
+    }
+    EXPECT_EQ(sum, 999 * 1000 / 2 - 10);
+
+    // early-exit search, the Entity is obtained from the iterator
+    auto found = std::ranges::find_if(sparseSet, [](const TestSSComp& comp) { return comp.value == 500; });
+    ASSERT_NE(found, sparseSet.end());
+    EXPECT_EQ(ec2s::SparseSet<TestSSComp>::ConstIterator(found), std::ranges::find_if(std::as_const(sparseSet), [](const TestSSComp& comp) { return comp.value == 500; }));
+    EXPECT_EQ(found.entity(), 500);
+    EXPECT_EQ((*found).value, 500);
+
+    // random access
+    EXPECT_EQ(sparseSet.end() - sparseSet.begin(), 999);
+    EXPECT_EQ(sparseSet.begin()[20].value, (*(sparseSet.begin() + 20)).value);
+
+    std::for_each(std::execution::par_unseq, sparseSet.begin(), sparseSet.end(), [](TestSSComp& comp) { comp.value *= 2; });
+    EXPECT_EQ(sparseSet[500].value, 1000);
+    EXPECT_EQ(std::ranges::count_if(sparseSet, [](const TestSSComp& comp) { return comp.value % 2 != 0; }), 0);
+}
@@ -0,0 +1,111 @@
+/*****************************************************************//**
+ * @file   AlignedAllocator.hpp
+ * @brief  header file of AlignedAllocator class
+ *
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_ALIGNEDALLOCATOR_HPP_
+#define EC2S_ALIGNEDALLOCATOR_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace ec2s
+{
+    /**
+     * @brief  allocator that obtains memory from a std::pmr::memory_resource with at least kAlignment alignment
+     * @details same as std::pmr::polymorphic_allocator except for the alignment, so that the head of an array can be loaded by aligned SIMD instructions
+     *
+     * @tparam T element type
+     * @tparam kAlignment minimum alignment of each allocation (power of two)
+     */
+    template <typename T, std::size_t kAlignment>
+    class AlignedAllocator
+    {
+        static_assert(kAlignment > 0 && (kAlignment & (kAlignment - 1)) == 0, "alignment must be a power of two!");
+
+    public:
+        using value_type = T;
+
+        //! the alignment is not deducible from the allocator type, so rebinding is given explicitly
+        template <typename U>
+        struct rebind
+        {
+            using other = AlignedAllocator<U, kAlignment>;
+        };
+
+        /**
+         * @brief  constructor (implicit, same as std::pmr::polymorphic_allocator)
+         *
+         * @param pMemoryResource memory resource from which memory is allocated
+         */
+        AlignedAllocator(std::pmr::memory_resource* const pMemoryResource = std::pmr::get_default_resource()) noexcept
+            : mpMemoryResource(pMemoryResource)
+        {
+        }
+
+        /**
+         * @brief  converting constructor (for rebinding)
+         *
+         * @param other allocator of another element type
+         */
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, kAlignment>& other) noexcept
+            : mpMemoryResource(other.resource())
+        {
+        }
+
+        /**
+         * @brief  allocate memory for n elements
+         *
+         * @param n number of elements
+         * @return pointer to the head of the memory (aligned to kAlignment)
+         */
+        T* allocate(const std::size_t n)
+        {
+            return static_cast<T*>(mpMemoryResource->allocate(n * sizeof(T), kAllocationAlignment));
+        }
+
+        /**
+         * @brief  deallocate memory allocated by allocate()
+         *
+         * @param p pointer returned by allocate()
+         * @param n number of elements passed to allocate()
+         */
+        void deallocate(T* const p, const std::size_t n)
+        {
+            mpMemoryResource->deallocate(p, n * sizeof(T), kAllocationAlignment);
+        }
+
+        /**
+         * @brief  get the memory resource
+         *
+         */
+        std::pmr::memory_resource* resource() const noexcept
+        {
+            return mpMemoryResource;
+        }
+
+        template <typename U>
+        friend bool operator==(const AlignedAllocator& lhs, const AlignedAllocator<U, kAlignment>& rhs) noexcept
+        {
+            return *lhs.resource() == *rhs.resource();
+        }
+
+    private:
+        //! alignment actually requested (over-aligned types keep their own alignment)
+        constexpr static std::size_t kAllocationAlignment = std::max(kAlignment, alignof(T));
+
+        //! memory resource from which memory is allocated
+        std::pmr::memory_resource* mpMemoryResource;
+    };
+
+    //! std::vector whose elements begin at a kAlignment boundary
+    template <typename T, std::size_t kAlignment>
+    using AlignedVector = std::vector<T, AlignedAllocator<T, kAlignment>>;
+}  // namespace ec2s
+
+#endif
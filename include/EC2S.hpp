@@ -8,6 +8,7 @@
  *********************************************************************/
 
 #include "Registry.hpp"
+#include "Observer.hpp"
 // optional
 #include "Application.hpp"
 #include "JobSystem.hpp"
@@ -0,0 +1,145 @@
+/*****************************************************************//**
+ * @file   EmptyStorage.hpp
+ * @brief  header file of EmptyStorage class
+ * 
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_EMPTYSTORAGE_HPP_
+#define EC2S_EMPTYSTORAGE_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+
+namespace ec2s
+{
+    /**
+     * @brief  vector-like container for empty (tag) types, which counts elements without storing them
+     * @details every element access returns the same shared instance
+     * 
+     * @tparam T empty element type
+     */
+    template <typename T>
+    class EmptyStorage
+    {
+        static_assert(std::is_empty_v<T> && std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>, "EmptyStorage is only for empty types constructed and destructed trivially!");
+
+    public:
+        /** 
+         * @brief  constructor
+         *  
+         * @param pMemoryResource unused (nothing is allocated)
+         */
+        explicit EmptyStorage(std::pmr::memory_resource* const = nullptr)
+            : mSize(0)
+        {
+        }
+
+        /** 
+         * @brief  adds an element at the end (nothing is stored)
+         * @details if arguments are given, the selected constructor still runs on a temporary, so its side effects are kept
+         *  
+         * @tparam Args types of arguments forwarded to the constructor of the temporary
+         * @param ...args arguments forwarded to the constructor of the temporary
+         * @return reference to the shared instance
+         */
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if constexpr (sizeof...(Args) > 0)
+            {
+                static_cast<void>(T(std::forward<Args>(args)...));
+            }
+
+            ++mSize;
+            return mSharedInstance;
+        }
+
+        /** 
+         * @brief  removes the last element
+         *  
+         */
+        void pop_back()
+        {
+            assert(mSize > 0 || !"pop_back() on empty EmptyStorage!");
+            --mSize;
+        }
+
+        /** 
+         * @brief  removes all elements
+         *  
+         */
+        void clear()
+        {
+            mSize = 0;
+        }
+
+        /** 
+         * @brief  does nothing (for interface compatibility)
+         *  
+         */
+        void reserve(const std::size_t)
+        {
+        }
+
+        /** 
+         * @brief  returns the number of elements
+         *  
+         * @return size
+         */
+        std::size_t size() const
+        {
+            return mSize;
+        }
+
+        /** 
+         * @brief  returns whether there is no element
+         *  
+         */
+        bool empty() const
+        {
+            return mSize == 0;
+        }
+
+        /** 
+         * @brief  operator overload for index access to element
+         *  
+         * @return reference to the shared instance
+         */
+        T& operator[](const std::size_t)
+        {
+            return mSharedInstance;
+        }
+
+        /** 
+         * @brief  operator overload for index access to element (const ver)
+         *  
+         * @return const reference to the shared instance
+         */
+        const T& operator[](const std::size_t) const
+        {
+            return mSharedInstance;
+        }
+
+        /** 
+         * @brief  reference to the last element
+         *  
+         * @return reference to the shared instance
+         */
+        T& back()
+        {
+            return mSharedInstance;
+        }
+
+    private:
+        //! instance shared by all elements
+        inline static T mSharedInstance{};
+        //! number of elements
+        std::size_t mSize;
+    };
+}  // namespace ec2s
+
+#endif
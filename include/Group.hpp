@@ -0,0 +1,293 @@
+/*****************************************************************//**
+ * @file   Group.hpp
+ * @brief  header file of Group class
+ * 
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_GROUP_HPP_
+#define EC2S_GROUP_HPP_
+
+#include <algorithm>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <cassert>
+
+#include "IGroup.hpp"
+#include "SparseSet.hpp"
+
+namespace ec2s
+{
+    /**
+     * @brief  owning Group class, keeps all entities that have every owned Component in the packed prefix of each owned SparseSet
+     * @details generated from Registry, iterating a Group is a lockstep walk over contiguous arrays without membership checks
+     * 
+     * @tparam ComponentType type of the first Component owned by this Group (each SparseSet can be owned by at most one Group)
+     * @tparam OtherComponentTypes subsequent owned Component types
+     */
+    template <typename ComponentType, typename... OtherComponentTypes>
+    class Group : public IGroup
+    {
+    public:
+        /** 
+         * @brief  constructor (collects the entities that already have all owned Components)
+         * @details user does not need to build this
+         * @param head reference to SparseSet of the first ComponentType
+         * @param tails reference to the SparseSet of the subsequent ComponentType
+         */
+        Group(SparseSet<ComponentType>& head, SparseSet<OtherComponentTypes>&... tails)
+            : mSparseSets(head, tails...)
+            , mSize(0)
+        {
+            std::apply([this](auto&... sparseSets) { (sparseSets.setOwningGroup(this), ...); }, mSparseSets);
+
+            // entities before mSize are members and the entity swapped into i has already been checked, so one pass is enough
+            const auto& entities = head.getDenseEntities();
+            for (std::size_t i = 0; i < entities.size(); ++i)
+            {
+                onConstruct(entities[i]);
+            }
+        }
+
+        /** 
+         * @brief  destructor (releases the owned SparseSets)
+         *  
+         */
+        virtual ~Group() override
+        {
+            std::apply([](auto&... sparseSets) { (sparseSets.setOwningGroup(nullptr), ...); }, mSparseSets);
+        }
+
+        Group(const Group&)            = delete;
+        Group& operator=(const Group&) = delete;
+
+        /** 
+         * @brief  returns the number of entities that have all owned Components
+         * @details i.e., each() is executed this many times
+         */
+        std::size_t size() const
+        {
+            return mSize;
+        }
+
+        /**
+         * @brief execute func on all owned Components of the member entities
+         * @tparam Func type of func (to be inferred)
+         * @tparam Traits::IsEligibleEachFunc user doesn't need to pass this, the Func type takes the owned Components as argument and executable or not
+         * @param func function object to be executed, lambda expression, etc.
+         */
+        template <typename Func, typename Traits::IsEligibleEachFunc<Func, ComponentType, OtherComponentTypes...>* = nullptr>
+        void each(Func func)
+        {
+            const auto& entities = std::get<0>(mSparseSets).getDenseEntities();
+            for (std::size_t i = 0; i < mSize; ++i)
+            {
+                func(std::get<SparseSet<ComponentType>&>(mSparseSets).getBySparseIndex(i, entities[i]), std::get<SparseSet<OtherComponentTypes>&>(mSparseSets).getBySparseIndex(i, entities[i])...);
+            }
+        }
+
+        /**
+         * @brief  execute func on all owned Components of the member entities with entity ID
+         * @tparam Func type of func (to be inferred)
+         * @tparam Traits::IsEligibleEachFunc user doesn't need to pass this, whether the func type can take Entity and the owned Components as arguments and execute it
+         * @param func function object to be executed, lambda expression, etc.
+         */
+        template <typename Func, typename Traits::IsEligibleEachFunc<Func, Entity, ComponentType, OtherComponentTypes...>* = nullptr>
+        void each(Func func)
+        {
+            const auto& entities = std::get<0>(mSparseSets).getDenseEntities();
+            for (std::size_t i = 0; i < mSize; ++i)
+            {
+                func(entities[i], std::get<SparseSet<ComponentType>&>(mSparseSets).getBySparseIndex(i, entities[i]), std::get<SparseSet<OtherComponentTypes>&>(mSparseSets).getBySparseIndex(i, entities[i])...);
+            }
+        }
+
+        /**
+         * @brief execute func on all owned Components of the member entities read only (const ver, never stamps the changed ticks)
+         * @tparam Func type of func (to be inferred), takes the const references of the owned Components
+         * @param func function object to be executed, lambda expression, etc.
+         */
+        template <typename Func, typename Traits::IsEligibleEachFunc<Func, const ComponentType, const OtherComponentTypes...>* = nullptr>
+        void each(Func func) const
+        {
+            const auto& entities = std::get<0>(mSparseSets).getDenseEntities();
+            for (std::size_t i = 0; i < mSize; ++i)
+            {
+                func(std::as_const(std::get<SparseSet<ComponentType>&>(mSparseSets)).getBySparseIndex(i, entities[i]), std::as_const(std::get<SparseSet<OtherComponentTypes>&>(mSparseSets)).getBySparseIndex(i, entities[i])...);
+            }
+        }
+
+        /**
+         * @brief  execute func on all owned Components of the member entities with entity ID read only (const ver, never stamps the changed ticks)
+         * @tparam Func type of func (to be inferred), takes Entity and the const references of the owned Components
+         * @param func function object to be executed, lambda expression, etc.
+         */
+        template <typename Func, typename Traits::IsEligibleEachFunc<Func, Entity, const ComponentType, const OtherComponentTypes...>* = nullptr>
+        void each(Func func) const
+        {
+            const auto& entities = std::get<0>(mSparseSets).getDenseEntities();
+            for (std::size_t i = 0; i < mSize; ++i)
+            {
+                func(entities[i], std::as_const(std::get<SparseSet<ComponentType>&>(mSparseSets)).getBySparseIndex(i, entities[i]), std::as_const(std::get<SparseSet<OtherComponentTypes>&>(mSparseSets)).getBySparseIndex(i, entities[i])...);
+            }
+        }
+
+        /**
+         * @brief  execute func on contiguous runs of the owned Components of the member entities (for explicit SIMD kernels)
+         * @details runs never cross a multiple of chunkSize (nor a page boundary of any owned SparseSet)
+         * @tparam Func type of func, takes SparseSet<T>::Chunk of each owned Component, optionally preceded by std::span<const Entity>
+         * @param func function object to be executed, lambda expression, etc.
+         * @param chunkSize maximum number of elements per call
+         */
+        template <typename Func>
+        void eachChunk(Func func, const std::size_t chunkSize = SparseSet<ComponentType>::kDefaultChunkSize)
+        {
+            eachChunkOf<false>(func, chunkSize);
+        }
+
+        /**
+         * @brief  execute func on contiguous runs of the owned Components of the member entities read only (const ver of eachChunk(), never stamps the changed ticks)
+         * @tparam Func type of func, takes SparseSet<T>::ConstChunk of each owned Component, optionally preceded by std::span<const Entity>
+         * @param func function object to be executed, lambda expression, etc.
+         * @param chunkSize maximum number of elements per call
+         */
+        template <typename Func>
+        void eachChunk(Func func, const std::size_t chunkSize = SparseSet<ComponentType>::kDefaultChunkSize) const
+        {
+            eachChunkOf<true>(func, chunkSize);
+        }
+
+        /** 
+         * @brief  moves the entity into the prefix if it has all owned Components
+         *  
+         * @param entity entity to which an owned Component was added
+         */
+        virtual void onConstruct(const Entity entity) override
+        {
+            if (!std::apply([entity](auto&... sparseSets) { return (sparseSets.contains(entity) && ...); }, mSparseSets) || isMember(entity))
+            {
+                return;
+            }
+
+            std::apply([this, entity](auto&... sparseSets) { (swapInto(sparseSets, entity, mSize), ...); }, mSparseSets);
+            ++mSize;
+        }
+
+        /** 
+         * @brief  moves the entity out of the prefix if it is a member
+         *  
+         * @param entity entity from which an owned Component is removed
+         */
+        virtual void onDestroy(const Entity entity) override
+        {
+            if (!isMember(entity))
+            {
+                return;
+            }
+
+            --mSize;
+            std::apply([this, entity](auto&... sparseSets) { (swapInto(sparseSets, entity, mSize), ...); }, mSparseSets);
+        }
+
+        /** 
+         * @brief  empties the prefix
+         *  
+         */
+        virtual void onClear() override
+        {
+            mSize = 0;
+        }
+
+        /** 
+         * @brief  get the type hash of this Group type
+         *  
+         * @return type hash of this Group type
+         */
+        virtual TypeHash getGroupTypeHash() const override
+        {
+            return TypeHasher::hash<Group<ComponentType, OtherComponentTypes...>>();
+        }
+
+    private:
+        /**
+         * @brief  implementation of eachChunk()
+         * @tparam kConst whether the chunks are obtained through the const SparseSets (never stamps the changed ticks)
+         * @param func function object to be executed
+         * @param chunkSize maximum number of elements per call
+         */
+        template <bool kConst, typename Func>
+        void eachChunkOf(Func& func, const std::size_t chunkSize) const
+        {
+            assert(chunkSize > 0 || !"chunkSize must be greater than 0!");
+
+            // the owned SparseSets are held by reference, so they are made const explicitly
+            const auto chunkOf = []<typename T>(SparseSet<T>& sparseSet, const std::size_t offset, const std::size_t count)
+            {
+                if constexpr (kConst)
+                {
+                    return std::as_const(sparseSet).getChunk(offset, count);
+                }
+                else
+                {
+                    return sparseSet.getChunk(offset, count);
+                }
+            };
+            using HeadChunk = std::conditional_t<kConst, typename SparseSet<ComponentType>::ConstChunk, typename SparseSet<ComponentType>::Chunk>;
+
+            const auto& entities = std::get<0>(mSparseSets).getDenseEntities();
+            for (std::size_t offset = 0; offset < mSize;)
+            {
+                const std::size_t count = std::apply([&](auto&... sparseSets) { return std::min({ chunkSize - offset % chunkSize, mSize - offset, sparseSets.getContiguousLength(offset)... }); }, mSparseSets);
+
+                if constexpr (std::is_invocable_v<Func, std::span<const Entity>, HeadChunk, std::conditional_t<kConst, typename SparseSet<OtherComponentTypes>::ConstChunk, typename SparseSet<OtherComponentTypes>::Chunk>...>)
+                {
+                    func(std::span<const Entity>(entities.data() + offset, count), chunkOf(std::get<SparseSet<ComponentType>&>(mSparseSets), offset, count), chunkOf(std::get<SparseSet<OtherComponentTypes>&>(mSparseSets), offset, count)...);
+                }
+                else
+                {
+                    func(chunkOf(std::get<SparseSet<ComponentType>&>(mSparseSets), offset, count), chunkOf(std::get<SparseSet<OtherComponentTypes>&>(mSparseSets), offset, count)...);
+                }
+
+                offset += count;
+            }
+        }
+
+        /** 
+         * @brief  whether the entity is currently in the prefix
+         *  
+         * @param entity entity to be checked
+         */
+        bool isMember(const Entity entity)
+        {
+            std::size_t sparseIndex = 0;
+            return std::get<0>(mSparseSets).contains(entity) && std::get<0>(mSparseSets).getSparseIndexIfValid(entity, sparseIndex) && sparseIndex < mSize;
+        }
+
+        /** 
+         * @brief  swap the element of the entity into the specified position of the SparseSet
+         *  
+         * @param sparseSet owned SparseSet
+         * @param entity entity to be moved
+         * @param position destination dense index
+         */
+        template <typename T>
+        static void swapInto(SparseSet<T>& sparseSet, const Entity entity, const std::size_t position)
+        {
+            std::size_t sparseIndex = 0;
+            sparseSet.getSparseIndexIfValid(entity, sparseIndex);
+            if (sparseIndex != position)
+            {
+                sparseSet.swapElements(sparseIndex, position);
+            }
+        }
+
+        //! tuple of all owned SparseSets
+        std::tuple<SparseSet<ComponentType>&, SparseSet<OtherComponentTypes>&...> mSparseSets;
+        //! number of member entities (length of the prefix)
+        std::size_t mSize;
+    };
+}  // namespace ec2s
+
+#endif
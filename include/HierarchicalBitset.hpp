@@ -0,0 +1,195 @@
+/*****************************************************************//**
+ * @file   HierarchicalBitset.hpp
+ * @brief  header file of HierarchicalBitset class
+ *
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_HIERARCHICALBITSET_HPP_
+#define EC2S_HIERARCHICALBITSET_HPP_
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <span>
+#include <vector>
+
+namespace ec2s
+{
+    /**
+     * @brief  bitset over entity indices with a 64-ary summary level (one summary bit per non-zero word)
+     * @details intersections of several bitsets are enumerated word by word, skipping whole 4096-index blocks by the summary \
+     *          and 64-index blocks by the words before any element is touched
+     */
+    class HierarchicalBitset
+    {
+    public:
+        //! number of bits in one word
+        constexpr static std::size_t kWordBits = 64;
+
+        /**
+         * @brief  constructor
+         *
+         * @param pMemoryResource memory resource from which the words are allocated
+         */
+        explicit HierarchicalBitset(std::pmr::memory_resource* const pMemoryResource = std::pmr::get_default_resource())
+            : mWords(pMemoryResource)
+            , mSummaryWords(pMemoryResource)
+        {
+        }
+
+        /**
+         * @brief  set the bit of the index (grows the words if needed)
+         *
+         * @param index index to be set
+         */
+        void set(const std::size_t index)
+        {
+            const std::size_t word = index / kWordBits;
+            if (word >= mWords.size())
+            {
+                mWords.resize(word + 1, 0);
+                mSummaryWords.resize(word / kWordBits + 1, 0);
+            }
+
+            mWords[word] |= bitOf(index);
+            mSummaryWords[word / kWordBits] |= bitOf(word);
+        }
+
+        /**
+         * @brief  reset the bit of the index
+         *
+         * @param index index to be reset
+         */
+        void reset(const std::size_t index)
+        {
+            const std::size_t word = index / kWordBits;
+            if (word >= mWords.size())
+            {
+                return;
+            }
+
+            mWords[word] &= ~bitOf(index);
+            if (mWords[word] == 0)
+            {
+                mSummaryWords[word / kWordBits] &= ~bitOf(word);
+            }
+        }
+
+        /**
+         * @brief  checks if the bit of the index is set
+         *
+         * @param index index to be checked
+         */
+        bool test(const std::size_t index) const
+        {
+            return (getWord(index / kWordBits) & bitOf(index)) != 0;
+        }
+
+        /**
+         * @brief  reset all bits
+         *
+         */
+        void clear()
+        {
+            mWords.clear();
+            mSummaryWords.clear();
+        }
+
+        /**
+         * @brief  get the word of 64 bits (0 if out of range)
+         *
+         * @param word index of the word
+         */
+        std::uint64_t getWord(const std::size_t word) const
+        {
+            return word < mWords.size() ? mWords[word] : 0;
+        }
+
+        /**
+         * @brief  get the summary word, whose bits tell which of the 64 words are non-zero (0 if out of range)
+         *
+         * @param summaryWord index of the summary word
+         */
+        std::uint64_t getSummaryWord(const std::size_t summaryWord) const
+        {
+            return summaryWord < mSummaryWords.size() ? mSummaryWords[summaryWord] : 0;
+        }
+
+        /**
+         * @brief  returns the number of summary words
+         *
+         */
+        std::size_t getSummaryWordNum() const
+        {
+            return mSummaryWords.size();
+        }
+
+        /**
+         * @brief  execute func on every index set in all of pIncluded and in none of pExcluded, in ascending order
+         *
+         * @tparam Func function type, takes the index (std::size_t)
+         * @param pIncluded bitsets which must have the index (at least one)
+         * @param pExcluded bitsets which must not have the index
+         * @param func function object to be executed
+         */
+        template<typename Func>
+        static void intersect(std::span<const HierarchicalBitset* const> pIncluded, std::span<const HierarchicalBitset* const> pExcluded, Func func)
+        {
+            std::size_t summaryWordNum = pIncluded[0]->getSummaryWordNum();
+            for (const HierarchicalBitset* const pBitset : pIncluded)
+            {
+                summaryWordNum = std::min(summaryWordNum, pBitset->getSummaryWordNum());
+            }
+
+            for (std::size_t summaryWord = 0; summaryWord < summaryWordNum; ++summaryWord)
+            {
+                std::uint64_t summary = ~0ull;
+                for (const HierarchicalBitset* const pBitset : pIncluded)
+                {
+                    summary &= pBitset->mSummaryWords[summaryWord];
+                }
+
+                // each set bit of the summary is a 64-index block that may have matches
+                for (; summary != 0; summary &= summary - 1)
+                {
+                    const std::size_t word = summaryWord * kWordBits + static_cast<std::size_t>(std::countr_zero(summary));
+
+                    std::uint64_t bits = ~0ull;
+                    for (const HierarchicalBitset* const pBitset : pIncluded)
+                    {
+                        bits &= pBitset->mWords[word];
+                    }
+                    for (const HierarchicalBitset* const pBitset : pExcluded)
+                    {
+                        bits &= ~pBitset->getWord(word);
+                    }
+
+                    for (; bits != 0; bits &= bits - 1)
+                    {
+                        func(word * kWordBits + static_cast<std::size_t>(std::countr_zero(bits)));
+                    }
+                }
+            }
+        }
+
+    private:
+        /**
+         * @brief  bit of the index in its word
+         *
+         */
+        constexpr static std::uint64_t bitOf(const std::size_t index)
+        {
+            return 1ull << (index % kWordBits);
+        }
+
+        //! bits of the indices
+        std::pmr::vector<std::uint64_t> mWords;
+        //! one bit per word, set if the word is non-zero
+        std::pmr::vector<std::uint64_t> mSummaryWords;
+    };
+}  // namespace ec2s
+
+#endif
@@ -0,0 +1,59 @@
+/*****************************************************************//**
+ * @file   IGroup.hpp
+ * @brief  header file of IGroup class
+ * 
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_IGROUP_HPP_
+#define EC2S_IGROUP_HPP_
+
+#include "Entity.hpp"
+#include "TypeHash.hpp"
+
+namespace ec2s
+{
+    /**
+     * @brief  interface to owning Group class (notified by the owned SparseSets to maintain their packed prefix)
+     */
+    class IGroup
+    {
+    public:
+        /** 
+         * @brief  destructor (virtual)
+         *  
+         */
+        virtual ~IGroup()
+        {
+        }
+
+        /** 
+         * @brief  called after an owned component has been added to the entity
+         *  
+         * @param entity entity to which the component was added
+         */
+        virtual void onConstruct(const Entity entity) = 0;
+
+        /** 
+         * @brief  called before an owned component is removed from the entity
+         *  
+         * @param entity entity from which the component is removed
+         */
+        virtual void onDestroy(const Entity entity) = 0;
+
+        /** 
+         * @brief  called when an owned SparseSet is cleared
+         *  
+         */
+        virtual void onClear() = 0;
+
+        /** 
+         * @brief  get the type hash of the concrete Group type
+         *  
+         * @return type hash of the concrete Group type
+         */
+        virtual TypeHash getGroupTypeHash() const = 0;
+    };
+}  // namespace ec2s
+
+#endif
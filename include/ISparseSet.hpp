@@ -8,7 +8,10 @@
 #ifndef EC2S_ISPARSESET_HPP_
 #define EC2S_ISPARSESET_HPP_
 
+#include <iterator>
+#include <memory_resource>
 #include <vector>
+#include <cassert>
 
 #ifndef NDEBUG
 #include <sstream>
@@ -16,9 +19,15 @@
 
 #include "TypeHash.hpp"
 #include "Entity.hpp"
+#include "IGroup.hpp"
+#include "HierarchicalBitset.hpp"
+#include "Signal.hpp"
 
 namespace ec2s
 {
+    //! logical time stamped to the elements when they are added or changed (advanced by Registry::advanceTick() at the end of each system run)
+    using Tick = std::uint64_t;
+
     /**
      * @brief  interface to Sparse Set container class (to change the process depending on the concrete element type)
      */
@@ -27,15 +36,79 @@ namespace ec2s
     public:
         //! represents invalid index
         constexpr static std::size_t kTombstone = std::numeric_limits<std::uint32_t>::max();
+        //! number of sparse indices stored in one page of the sparse array (power of two)
+        constexpr static std::size_t kSparsePageSize = 4096;
+        //! marks a removed element in DenseEntities until compaction
+        constexpr static Entity kTombstoneEntity = kInvalidEntity;
+        //! batches smaller than 1 / kBatchCompactionRatio of the size are removed by swap-remove instead of compaction
+        constexpr static std::size_t kBatchCompactionRatio = 8;
+        //! with in-place deletion, adding an element compacts first if more than 1 / kAutoCompactionRatio of DenseEntities are tombstones (deferred while iterating)
+        constexpr static std::size_t kAutoCompactionRatio = 4;
+
+        /**
+         * @brief  scope during which the SparseSet is being iterated, so that adding elements never compacts (and reorders) the arrays
+         */
+        class IterationScope
+        {
+        public:
+            /** 
+             * @brief  constructor
+             *  
+             * @param sparseSet SparseSet being iterated
+             */
+            explicit IterationScope(const ISparseSet& sparseSet)
+                : mSparseSet(sparseSet)
+            {
+                ++mSparseSet.mIterationDepth;
+            }
+
+            /** 
+             * @brief  destructor
+             *  
+             */
+            ~IterationScope()
+            {
+                --mSparseSet.mIterationDepth;
+            }
+
+            IterationScope(const IterationScope&)            = delete;
+            IterationScope& operator=(const IterationScope&) = delete;
+
+        private:
+            //! SparseSet being iterated
+            const ISparseSet& mSparseSet;
+        };
 
         /** 
          * @brief  constructor
          *  
+         * @param pMemoryResource memory resource from which all arrays are allocated
          */
-        ISparseSet()
+        ISparseSet(std::pmr::memory_resource* const pMemoryResource)
+            : mSparsePages(pMemoryResource)
+            , mDenseEntities(pMemoryResource)
+            , mpOwningGroup(nullptr)
+            , mInPlaceDelete(false)
+            , mTombstoneNum(0)
+            , mIterationDepth(0)
+            , mStride(0)
+            , mMembership(pMemoryResource)
+            , mTrackMembership(false)
+            , mOnConstruct(pMemoryResource)
+            , mOnUpdate(pMemoryResource)
+            , mOnDestroy(pMemoryResource)
+            , mCurrentTick(1)
+            , mAddedTicks(pMemoryResource)
+            , mChangedTicks(pMemoryResource)
         {
         }
 
+        /** 
+         * @brief  move constructor (the arrays keep their memory resource, the owning Group is not re-bound)
+         *  
+         */
+        ISparseSet(ISparseSet&&) = default;
+
         /** 
          * @brief  destructor (virtual)
          *  
@@ -53,20 +126,35 @@ namespace ec2s
         {
             auto index = static_cast<std::size_t>(entity & kEntityIndexMask);
 
-            if (index >= mSparseIndices.size())
+            std::size_t sparseIndex = getSparseIndex(index);
+            if (sparseIndex == kTombstone || (mDenseEntities[sparseIndex] & kEntitySlotMask) != (entity & kEntitySlotMask))
             {
                 return;
             }
 
-            const std::size_t sparseIndex = mSparseIndices[index];
-            if (sparseIndex == kTombstone || (mDenseEntities[sparseIndex] & kEntitySlotMask) != (entity & kEntitySlotMask))
+            // listeners can still read the element
+            mOnDestroy.publish(entity);
+
+            if (mInPlaceDelete)
             {
+                // leave a tombstone, the element is destructed at the next compaction
+                mDenseEntities[sparseIndex] = kTombstoneEntity;
+                assureSparseIndex(index)    = kTombstone;
+                ++mTombstoneNum;
+                resetMembership(index);
                 return;
             }
 
+            if (mpOwningGroup)
+            {
+                // move the entity out of the group's prefix first
+                mpOwningGroup->onDestroy(entity);
+                sparseIndex = getSparseIndex(index);
+            }
+
             // swap-remove (O(1))
             std::swap(mDenseEntities[sparseIndex], mDenseEntities.back());
-            mSparseIndices[static_cast<std::size_t>(mDenseEntities[sparseIndex] & kEntityIndexMask)] = sparseIndex;
+            assureSparseIndex(static_cast<std::size_t>(mDenseEntities[sparseIndex] & kEntityIndexMask)) = sparseIndex;
 
             mDenseEntities.pop_back();
 
@@ -74,7 +162,80 @@ namespace ec2s
             this->removePackedElement(sparseIndex);
 
             // clear index
-            mSparseIndices[index] = kTombstone;
+            assureSparseIndex(index) = kTombstone;
+            resetMembership(index);
+        }
+
+        /** 
+         * @brief  remove the elements of all Entities in [first, last)
+         * @details victims are marked first and all arrays are compacted in one linear pass (the relative order of the rest is kept) \
+         *          onDestroy() is published once per contained Entity even if it appears more than once, \
+         *          and listeners must not iterate this SparseSet since the victims already published are marked in place
+         *  
+         * @tparam EntityItr forward iterator type of Entities
+         * @param first first Entity
+         * @param last end of Entities
+         */
+        template <typename EntityItr>
+        void remove(EntityItr first, EntityItr last)
+        {
+            if (mInPlaceDelete || static_cast<std::size_t>(std::distance(first, last)) * kBatchCompactionRatio < mDenseEntities.size())
+            {
+                // a linear pass over the whole array does not pay off
+                for (; first != last; ++first)
+                {
+                    remove(*first);
+                }
+                return;
+            }
+
+            // each victim is marked right after it is published and moved out of the group's prefix, so duplicated Entities are visited once
+            // (marked elements are always behind the prefix, so the group never swaps them)
+            bool marked = false;
+            for (; first != last; ++first)
+            {
+                const Entity entity = *first;
+                if (!contains(entity))
+                {
+                    continue;
+                }
+
+                // listeners can still read the element
+                mOnDestroy.publish(entity);
+
+                if (mpOwningGroup)
+                {
+                    mpOwningGroup->onDestroy(entity);
+                }
+
+                std::size_t& sparseIndex    = assureSparseIndex(static_cast<std::size_t>(entity & kEntityIndexMask));
+                mDenseEntities[sparseIndex] = kTombstoneEntity;
+                sparseIndex                 = kTombstone;
+                marked                      = true;
+                resetMembership(static_cast<std::size_t>(entity & kEntityIndexMask));
+            }
+
+            if (marked)
+            {
+                this->compactPackedElement();
+            }
+        }
+
+        /** 
+         * @brief  reclaim all tombstones left by in-place deletion in one linear pass (must not be called while iterating)
+         *  
+         */
+        void compact()
+        {
+            assert(mIterationDepth == 0 || !"compacted while iterating!");
+
+            if (mTombstoneNum == 0)
+            {
+                return;
+            }
+
+            this->compactPackedElement();
+            mTombstoneNum = 0;
         }
 
         /** 
@@ -83,11 +244,29 @@ namespace ec2s
          */
         void clear()
         {
-            mSparseIndices.clear();
+            if (!mOnDestroy.empty())
+            {
+                for (const Entity entity : mDenseEntities)
+                {
+                    if (entity != kTombstoneEntity)
+                    {
+                        mOnDestroy.publish(entity);
+                    }
+                }
+            }
+
+            mSparsePages.clear();
             mDenseEntities.clear();
+            mTombstoneNum = 0;
+            mMembership.clear();
 
             // destruct elements
             this->clearPackedElement();
+
+            if (mpOwningGroup)
+            {
+                mpOwningGroup->onClear();
+            }
         }
 
         /** 
@@ -96,46 +275,255 @@ namespace ec2s
          * @param entity entity to be checked 
          * @return whether the entity has been included
          */
-        bool contains(const Entity entity)
+        bool contains(const Entity entity) const
         {
             const auto index = static_cast<std::size_t>(entity & kEntityIndexMask);
 
-            if (index >= mSparseIndices.size())
+            const std::size_t sparseIndex = getSparseIndex(index);
+
+            return sparseIndex != kTombstone && (mDenseEntities[sparseIndex] & kEntitySlotMask) == (entity & kEntitySlotMask);
+        }
+
+        /** 
+         * @brief  re-registers the element held at the index of the Entity under the Entity itself, keeping its position
+         * @details for an entity index recycled with another generation while its element was kept (e.g. by Observer)
+         *  
+         * @param entity Entity whose index has an element registered under another generation
+         */
+        void rebind(const Entity entity)
+        {
+            const std::size_t sparseIndex = getSparseIndex(static_cast<std::size_t>(entity & kEntityIndexMask));
+            assert(sparseIndex != kTombstone || !"no element is registered at the index!");
+
+            mDenseEntities[sparseIndex] = entity;
+        }
+
+        /** 
+         * @brief  swaps two elements (and their entities) in the dense/packed arrays while keeping sparse indices consistent
+         *  
+         * @param lhs dense index of the first element
+         * @param rhs dense index of the second element
+         */
+        void swapElements(const std::size_t lhs, const std::size_t rhs)
+        {
+            assert((lhs < mDenseEntities.size() && rhs < mDenseEntities.size()) || !"swapped invalid index!");
+
+            std::swap(mDenseEntities[lhs], mDenseEntities[rhs]);
+            if (mDenseEntities[lhs] != kTombstoneEntity)
+            {
+                assureSparseIndex(static_cast<std::size_t>(mDenseEntities[lhs] & kEntityIndexMask)) = lhs;
+            }
+            if (mDenseEntities[rhs] != kTombstoneEntity)
             {
-                return false;
+                assureSparseIndex(static_cast<std::size_t>(mDenseEntities[rhs] & kEntityIndexMask)) = rhs;
             }
 
-            const std::size_t sparseIndex = mSparseIndices[index];
-            
-            return sparseIndex != kTombstone && (mDenseEntities[sparseIndex] & kEntitySlotMask) == (entity & kEntitySlotMask);
+            this->swapPackedElement(lhs, rhs);
+        }
+
+        /** 
+         * @brief  reorders elements to follow the dense order of the other SparseSet
+         * @details elements shared with the other come first in the other's order, the rest follow in an unspecified order
+         *  
+         * @param other SparseSet whose order is followed
+         */
+        void sortAs(const ISparseSet& other)
+        {
+            assert(!mpOwningGroup || !"SparseSet owned by a group cannot be sorted!");
+
+            compact();
+
+            std::size_t pos = 0;
+
+            for (const auto& entity : other.mDenseEntities)
+            {
+                if (!contains(entity))
+                {
+                    continue;
+                }
+
+                const std::size_t sparseIndex = getSparseIndex(static_cast<std::size_t>(entity & kEntityIndexMask));
+                if (sparseIndex != pos)
+                {
+                    swapElements(sparseIndex, pos);
+                }
+
+                ++pos;
+            }
+        }
+
+        /** 
+         * @brief  set the Group that owns this SparseSet (nullptr to release)
+         *  
+         * @param pGroup owning Group
+         */
+        void setOwningGroup(IGroup* const pGroup)
+        {
+            assert(!pGroup || !mpOwningGroup || !"SparseSet is already owned by another group!");
+            assert(!pGroup || !mInPlaceDelete || !"SparseSet with in-place deletion cannot be owned by a group!");
+            mpOwningGroup = pGroup;
+        }
+
+        /** 
+         * @brief  get the Group that owns this SparseSet
+         *  
+         * @return owning Group (nullptr if not owned)
+         */
+        IGroup* getOwningGroup() const
+        {
+            return mpOwningGroup;
         }
 
         /** 
          * @brief  returns the actual number of elements
          *  
-         * @return size
+         * @return size (tombstones are not counted)
          */
         std::size_t size() const
         {
-            return mDenseEntities.size();
+            return mDenseEntities.size() - mTombstoneNum;
+        }
+
+        /** 
+         * @brief  get the raw pointer to the element of the specified entity (for type-erased access, e.g. RuntimeView)
+         * @details this is mutable access, so the changed tick is stamped if the Component type keeps ticks (read through the const overload to avoid it)
+         *  
+         * @param entity entity whose element is obtained
+         * @return pointer to the element, nullptr if the entity does not have it or the elements are not stored as an array of the type (getStride() == 0)
+         */
+        void* getRaw(const Entity entity)
+        {
+            const std::size_t sparseIndex = getRawSparseIndex(entity);
+            return sparseIndex == kTombstone ? nullptr : getRawPackedElement(sparseIndex);
         }
 
         /** 
-         * @brief  resize sparseIndices
+         * @brief  get the raw pointer to the element of the specified entity (const ver, never stamps the changed tick)
+         *  
+         * @param entity entity whose element is obtained
+         * @return pointer to the element, nullptr if the entity does not have it or the elements are not stored as an array of the type (getStride() == 0)
+         */
+        const void* getRaw(const Entity entity) const
+        {
+            const std::size_t sparseIndex = getRawSparseIndex(entity);
+            return sparseIndex == kTombstone ? nullptr : getRawPackedElement(sparseIndex);
+        }
+
+        /** 
+         * @brief  returns the size in bytes of one element pointed to by getRaw() (the distance between adjacent elements within a page)
+         *  
+         * @return stride of the elements, 0 for empty types and structure-of-arrays (no raw access)
+         */
+        std::size_t getStride() const
+        {
+            return mStride;
+        }
+
+        /** 
+         * @brief  signal published after an element is added to a new Entity
+         *  
+         * @return reference to the signal
+         */
+        Signal& onConstruct()
+        {
+            return mOnConstruct;
+        }
+
+        /** 
+         * @brief  signal published after an element is replaced or patched
+         *  
+         * @return reference to the signal
+         */
+        Signal& onUpdate()
+        {
+            return mOnUpdate;
+        }
+
+        /** 
+         * @brief  signal published before an element is removed (including remove by range and clear)
+         *  
+         * @return reference to the signal
+         */
+        Signal& onDestroy()
+        {
+            return mOnDestroy;
+        }
+
+        /** 
+         * @brief  set the tick stamped to the elements added or changed from now on (called by Registry::advanceTick())
+         *  
+         * @param tick current tick
+         */
+        void setCurrentTick(const Tick tick)
+        {
+            mCurrentTick = tick;
+        }
+
+        /** 
+         * @brief  get the tick stamped to the elements added or changed from now on
+         *  
+         * @return current tick
+         */
+        Tick getCurrentTick() const
+        {
+            return mCurrentTick;
+        }
+
+        /** 
+         * @brief  get the Entity (with its generation) registered at the specified entity index
+         *  
+         * @param index index part of the entity
+         * @return registered Entity, kInvalidEntity if there is none
+         */
+        Entity getEntityByIndex(const std::size_t index) const
+        {
+            const std::size_t sparseIndex = getSparseIndex(index);
+            return sparseIndex == kTombstone ? kInvalidEntity : mDenseEntities[sparseIndex];
+        }
+
+        /** 
+         * @brief  get the bitset of the entity indices having an element (maintained only if Traits::ComponentTraits enables kMembershipBitset)
+         *  
+         * @return pointer to the bitset, nullptr if it is not maintained
+         */
+        const HierarchicalBitset* getMembership() const
+        {
+            return mTrackMembership ? &mMembership : nullptr;
+        }
+
+        /** 
+         * @brief  returns the number of tombstones left by in-place deletion
+         *  
+         * @return number of tombstones
+         */
+        std::size_t getTombstoneNum() const
+        {
+            return mTombstoneNum;
+        }
+
+        /** 
+         * @brief  resize the page table of sparse indices so that it covers maxIndex
+         * @details pages themselves are not allocated here, they are allocated lazily on first write
          *  
          * @param maxIndex
          */
         void resizeSparseIndex(const std::size_t maxIndex)
         {
-            mSparseIndices.resize(maxIndex, kTombstone);
+            const std::size_t pageNum = (maxIndex + kSparsePageSize - 1) / kSparsePageSize;
+            if (pageNum > mSparsePages.size())
+            {
+                mSparsePages.resize(pageNum);
+            }
         }
 
         /** 
          * @brief  return reference to denseEntities
+         * @details with in-place deletion, removed elements remain as kTombstoneEntity until compaction, \
+         *          so callers must skip them (or compact() first when no iteration is in progress)
          *  
          * @return reference to denseEntities
          */
-        const std::vector<Entity>& getDenseEntities() const
+        const std::pmr::vector<Entity>& getDenseEntities() const
         {
             return mDenseEntities;
         }
@@ -150,9 +538,13 @@ namespace ec2s
             std::ostringstream oss;
             oss << "index dump : \n";
             oss << "sparse : \n";
-            for (int i = 0; auto& e : mSparseIndices)
+            for (std::size_t page = 0; page < mSparsePages.size(); ++page)
             {
-                oss << i++ << " : " << e << "\n";
+                // unallocated pages hold only tombstones
+                for (std::size_t i = 0; i < mSparsePages[page].size(); ++i)
+                {
+                    oss << page * kSparsePageSize + i << " : " << mSparsePages[page][i] << "\n";
+                }
             }
 
             oss << "dense : \n";
@@ -167,6 +559,103 @@ namespace ec2s
         }
 
     protected:
+        /** 
+         * @brief  obtain the sparse index of the element of the specified entity for raw access
+         *  
+         * @param entity entity whose element is obtained
+         * @return sparse index, kTombstone if the entity does not have the element or it has no raw access (getStride() == 0)
+         */
+        std::size_t getRawSparseIndex(const Entity entity) const
+        {
+            const std::size_t sparseIndex = getSparseIndex(static_cast<std::size_t>(entity & kEntityIndexMask));
+
+            if (mStride == 0 || sparseIndex == kTombstone || (mDenseEntities[sparseIndex] & kEntitySlotMask) != (entity & kEntitySlotMask))
+            {
+                return kTombstone;
+            }
+
+            return sparseIndex;
+        }
+
+        /** 
+         * @brief  reclaim the tombstones before adding elements if they exceed 1 / kAutoCompactionRatio of DenseEntities and no iteration is in progress
+         *  
+         */
+        void compactIfSparse()
+        {
+            if (mIterationDepth == 0 && mTombstoneNum * kAutoCompactionRatio > mDenseEntities.size())
+            {
+                compact();
+            }
+        }
+
+        /** 
+         * @brief  obtain the sparse index (index to DenseEntities) of the specified entity index
+         *  
+         * @param index index part of the entity
+         * @return sparse index, kTombstone if not registered (or its page has not been allocated)
+         */
+        std::size_t getSparseIndex(const std::size_t index) const
+        {
+            const std::size_t page = index / kSparsePageSize;
+
+            if (page >= mSparsePages.size() || mSparsePages[page].empty())
+            {
+                return kTombstone;
+            }
+
+            return mSparsePages[page][index & (kSparsePageSize - 1)];
+        }
+
+        /** 
+         * @brief  obtain a writable sparse index of the specified entity index, allocating its page if it does not exist
+         *  
+         * @param index index part of the entity
+         * @return reference to the sparse index
+         */
+        std::size_t& assureSparseIndex(const std::size_t index)
+        {
+            const std::size_t page = index / kSparsePageSize;
+
+            if (page >= mSparsePages.size())
+            {
+                mSparsePages.resize(page + 1);
+            }
+
+            if (mSparsePages[page].empty())
+            {
+                mSparsePages[page].resize(kSparsePageSize, kTombstone);
+            }
+
+            return mSparsePages[page][index & (kSparsePageSize - 1)];
+        }
+
+        /** 
+         * @brief  records that the entity index has an element (if the membership bitset is maintained)
+         *  
+         * @param index index part of the entity
+         */
+        void setMembership(const std::size_t index)
+        {
+            if (mTrackMembership)
+            {
+                mMembership.set(index);
+            }
+        }
+
+        /** 
+         * @brief  records that the entity index no longer has an element (if the membership bitset is maintained)
+         *  
+         * @param index index part of the entity
+         */
+        void resetMembership(const std::size_t index)
+        {
+            if (mTrackMembership)
+            {
+                mMembership.reset(index);
+            }
+        }
+
         /** 
          * @brief  type-dependent implementation of element destruction (left to child classes)
          *  
@@ -174,16 +663,99 @@ namespace ec2s
          */
         virtual void removePackedElement(std::size_t index) = 0;
 
+        /** 
+         * @brief  type-dependent implementation of compaction, removes all elements marked by kTombstoneEntity in one linear pass (left to child classes)
+         * @details the relative order of the remaining elements must be kept
+         */
+        virtual void compactPackedElement() = 0;
+
+        /** 
+         * @brief  reorders elements by the permutation (order[i] is the current dense index of the element to be placed at i)
+         *  
+         * @param order permutation of dense indices (destroyed)
+         */
+        void applyPermutation(std::vector<std::size_t>& order)
+        {
+            assert(!mpOwningGroup || !"SparseSet owned by a group cannot be sorted!");
+
+            for (std::size_t i = 0; i < order.size(); ++i)
+            {
+                std::size_t current = i;
+                std::size_t next    = order[current];
+
+                // follow the cycle, each swap settles one element
+                while (next != i)
+                {
+                    swapElements(current, next);
+                    order[current] = current;
+                    current        = next;
+                    next           = order[current];
+                }
+
+                order[current] = current;
+            }
+        }
+
+        /** 
+         * @brief  type-dependent implementation of element swapping (left to child classes)
+         *  
+         * @param lhs index of the first element
+         * @param rhs index of the second element
+         */
+        virtual void swapPackedElement(std::size_t lhs, std::size_t rhs) = 0;
+
+        /** 
+         * @brief  type-dependent implementation of raw element access (left to child classes, stamps the changed tick)
+         *  
+         * @param sparseIndex index of the element
+         * @return pointer to the element
+         */
+        virtual void* getRawPackedElement(std::size_t sparseIndex) = 0;
+
+        /** 
+         * @brief  type-dependent implementation of raw element access (const ver, left to child classes, never stamps)
+         *  
+         * @param sparseIndex index of the element
+         * @return pointer to the element
+         */
+        virtual const void* getRawPackedElement(std::size_t sparseIndex) const = 0;
+
         /** 
          * @brief  type-dependent implementation of all element destruction (left to child classes)
          *  
          */
         virtual void clearPackedElement() = 0;
 
-        //! sparse index to DenceEntities (mapping from Entity to DenseEntities)
-        std::vector<std::size_t> mSparseIndices;
+        //! paged sparse index to DenceEntities (mapping from Entity to DenseEntities), an empty page is not allocated
+        std::pmr::vector<std::pmr::vector<std::size_t>> mSparsePages;
         //! actual dense Entity
-        std::vector<Entity> mDenseEntities;
+        std::pmr::vector<Entity> mDenseEntities;
+        //! Group keeping its entities in the prefix of this SparseSet (nullptr if not owned)
+        IGroup* mpOwningGroup;
+        //! whether removal leaves a tombstone (set by the child class from Traits::ComponentTraits)
+        bool mInPlaceDelete;
+        //! number of tombstones in DenseEntities
+        std::size_t mTombstoneNum;
+        //! number of iterations in progress (IterationScope, also counted by const iterations), auto compaction is deferred while it is not 0
+        mutable std::size_t mIterationDepth;
+        //! size in bytes of one element for raw access (set by the child class, 0 if not stored as an array of the type)
+        std::size_t mStride;
+        //! entity indices having an element, summarized hierarchically for intersections in View
+        HierarchicalBitset mMembership;
+        //! whether mMembership is maintained (set by the child class from Traits::ComponentTraits)
+        bool mTrackMembership;
+        //! published after an element is added to a new Entity
+        Signal mOnConstruct;
+        //! published after an element is replaced or patched
+        Signal mOnUpdate;
+        //! published before an element is removed
+        Signal mOnDestroy;
+        //! tick stamped to the elements added or changed from now on
+        Tick mCurrentTick;
+        //! tick at which each packed element was added (maintained by the child class only if Traits::ComponentTraits enables kChangeTicks)
+        std::pmr::vector<Tick> mAddedTicks;
+        //! tick at which each packed element was last added or changed (same condition as mAddedTicks)
+        std::pmr::vector<Tick> mChangedTicks;
     };
 }  // namespace ec2s
 
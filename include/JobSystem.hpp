@@ -9,7 +9,10 @@
 #ifndef EC2S_INCLUDE_JOBSYSTEM_HPP_
 #define EC2S_INCLUDE_JOBSYSTEM_HPP_
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <latch>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -37,6 +40,8 @@ namespace ec2s
     public:
         //! Job handle expression
         using JobHandle = Job*;
+        //! default number of elements processed by one job of parallelFor()
+        constexpr static std::size_t kDefaultGrainSize = 4096;
 
     public:
         /** 
@@ -60,23 +65,25 @@ namespace ec2s
          */
         ~JobSystem()
         {
-            // double check
             if (!mStop)
             {
-                std::lock_guard<std::mutex> lock(mMutex);
-                if (!mStop)
-                {
-                    stop();
-                }
+                stop();
             }
         }
 
         /** 
          * @brief  restart the stopped JobSystem (all worker threads)
+         * @details must be called only after stop() (join() does both), jobs can be executed again afterwards
          *  
          */
         void restart()
         {
+            assert(std::none_of(mWorkerThreads.begin(), mWorkerThreads.end(), [](const std::thread& thread) { return thread.joinable(); }) || !"restarted without being stopped!");
+
+            {
+                std::lock_guard<std::mutex> lock(mMutex);
+                mStop = false;
+            }
 
             for (auto& thread : mWorkerThreads)
             {
@@ -121,6 +128,8 @@ namespace ec2s
                 std::lock_guard<std::mutex> lock(mMutex);
                 return &(mJobs.emplace(Job{ .task = f }));
             }
+
+            return nullptr;
         }
 
         /** 
@@ -175,6 +184,50 @@ namespace ec2s
             }
         }
 
+        /** 
+         * @brief  splits [0, count) into ranges of grainSize, executes func(begin, end) for each range on the worker threads and blocks until all of them finish
+         * @details the calling thread processes the first range itself, ranges that cannot be scheduled (stopped JobSystem) are also processed by the calling thread \
+         *          func is invoked concurrently and must not throw, do not call this from a worker thread of the same JobSystem (all workers may end up waiting)
+         *  
+         * @tparam Func type of specified function, callable as func(std::size_t begin, std::size_t end)
+         * @param count number of elements
+         * @param grainSize maximum number of elements per range
+         * @param func specified function
+         */
+        template <typename Func>
+        void parallelFor(const std::size_t count, const std::size_t grainSize, const Func& func)
+        {
+            if (count == 0)
+            {
+                return;
+            }
+
+            const std::size_t grain    = std::max(grainSize, static_cast<std::size_t>(1));
+            const std::size_t rangeNum = (count + grain - 1) / grain;
+            std::latch latch(static_cast<std::ptrdiff_t>(rangeNum));
+
+            for (std::size_t range = 1; range < rangeNum; ++range)
+            {
+                const std::size_t begin = range * grain;
+                const std::size_t end   = std::min(begin + grain, count);
+                const auto task         = [&func, &latch, begin, end]()
+                {
+                    func(begin, end);
+                    latch.count_down();
+                };
+
+                if (mStop || !exec(task))
+                {
+                    task();
+                }
+            }
+
+            func(0, std::min(grain, count));
+            latch.count_down();
+
+            latch.wait();
+        }
+
         /** 
          * @brief  stop all worker threads
          *  
@@ -190,12 +243,15 @@ namespace ec2s
 
             for (auto& thread : mWorkerThreads)
             {
-                thread.join();
+                if (thread.joinable())
+                {
+                    thread.join();
+                }
             }
         }
 
         /** 
-         * @brief  join all worker threads once and restart them
+         * @brief  join all worker threads once and restart them (all registered jobs are finished, and the JobSystem accepts jobs again)
          *  
          */
         void join()
@@ -225,8 +281,8 @@ namespace ec2s
         std::mutex mMutex;
         //! jobs queue
         std::queue<Job> mJobs;
-        //! flag indicating whether the system is stopped
-        bool mStop;
+        //! flag indicating whether the system is stopped (written under mMutex, but also read without it by the scheduling functions)
+        std::atomic<bool> mStop;
         // ------------------
     };
 
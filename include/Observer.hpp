@@ -0,0 +1,267 @@
+/*****************************************************************//**
+ * @file   Observer.hpp
+ * @brief  header file of Observer class
+ *
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_OBSERVER_HPP_
+#define EC2S_OBSERVER_HPP_
+
+#include <algorithm>
+#include <memory_resource>
+#include <vector>
+
+#include "Registry.hpp"
+#include "Signal.hpp"
+#include "SparseSet.hpp"
+
+namespace ec2s
+{
+    /**
+     * @brief  collects the Entities whose observed Components were constructed, updated (add to an existing one or Registry::patch) or destroyed
+     * @details each Entity is held once however many events it receives, so a system draining it costs O(changes) instead of O(entities) \
+     *          (keyed by the entity index, so a handle destroyed and recycled before the drain is replaced by the new one) \
+     *          the drained Entities can be filtered by the Components they have at that time with where() and exclude() \
+     *          it is bound to the Registry by its address, so it can be neither copied nor moved and must be destroyed before the Registry
+     */
+    class Observer
+    {
+    public:
+        /**
+         * @brief  constructor
+         *
+         * @param registry Registry whose signals are observed
+         * @param pMemoryResource memory resource from which the collected Entities are allocated
+         */
+        explicit Observer(Registry& registry, std::pmr::memory_resource* const pMemoryResource = std::pmr::get_default_resource())
+            : mRegistry(registry)
+            , mCollected(pMemoryResource)
+            , mDraining(pMemoryResource)
+            , mpSignals(pMemoryResource)
+            , mpRequired(nullptr)
+            , mpExcluded(nullptr)
+        {
+        }
+
+        //! the address is connected to the signals
+        Observer(const Observer&) = delete;
+        //! the address is connected to the signals
+        Observer& operator=(const Observer&) = delete;
+
+        /**
+         * @brief  destructor, disconnects from all the observed signals
+         *
+         */
+        ~Observer()
+        {
+            disconnect();
+        }
+
+        /**
+         * @brief  collect the Entities to which the Component type T is added
+         *
+         * @tparam T component type
+         * @return reference to this (for chaining)
+         */
+        template <typename T>
+        Observer& observeConstruct()
+        {
+            connect(mRegistry.onConstruct<T>());
+            return *this;
+        }
+
+        /**
+         * @brief  collect the Entities whose Component of type T is replaced or patched
+         *
+         * @tparam T component type
+         * @return reference to this (for chaining)
+         */
+        template <typename T>
+        Observer& observeUpdate()
+        {
+            connect(mRegistry.onUpdate<T>());
+            return *this;
+        }
+
+        /**
+         * @brief  collect the Entities whose Component of type T is removed (the Entity may have been destroyed when drained)
+         *
+         * @tparam T component type
+         * @return reference to this (for chaining)
+         */
+        template <typename T>
+        Observer& observeDestroy()
+        {
+            connect(mRegistry.onDestroy<T>());
+            return *this;
+        }
+
+        /**
+         * @brief  drain only the Entities having all of the Component types Required (checked in each(), replaces the previous where())
+         *
+         * @tparam Required component types the drained Entities must have
+         * @return reference to this (for chaining)
+         */
+        template <typename... Required>
+        Observer& where()
+        {
+            mpRequired = [](Registry& registry, const Entity entity) { return registry.containsAll<Required...>(entity); };
+            return *this;
+        }
+
+        /**
+         * @brief  drain only the Entities having none of the Component types Excluded (checked in each(), replaces the previous exclude())
+         *
+         * @tparam Excluded component types the drained Entities must not have
+         * @return reference to this (for chaining)
+         */
+        template <typename... Excluded>
+        Observer& exclude()
+        {
+            mpExcluded = [](Registry& registry, const Entity entity) { return (registry.contains<Excluded>(entity) || ...); };
+            return *this;
+        }
+
+        /**
+         * @brief  disconnect from all the observed signals (the collected Entities are kept)
+         *
+         */
+        void disconnect()
+        {
+            for (Signal* const pSignal : mpSignals)
+            {
+                pSignal->disconnect(this);
+            }
+            mpSignals.clear();
+        }
+
+        /**
+         * @brief  returns the number of collected Entities
+         *
+         */
+        std::size_t size() const
+        {
+            return mCollected.size();
+        }
+
+        /**
+         * @brief  checks if no Entity has been collected
+         *
+         */
+        bool empty() const
+        {
+            return mCollected.size() == 0;
+        }
+
+        /**
+         * @brief  checks if the Entity has been collected
+         *
+         * @param entity Entity to be checked
+         */
+        bool contains(const Entity entity) const
+        {
+            return mCollected.contains(entity);
+        }
+
+        /**
+         * @brief  obtains the collected Entities (in the order of their first event, before the filter of where() and exclude() is applied)
+         *
+         */
+        const std::pmr::vector<Entity>& getEntities() const
+        {
+            return mCollected.getDenseEntities();
+        }
+
+        /**
+         * @brief  execute func on each collected Entity passing the filter of where() and exclude(), then clear them all (drain)
+         * @details Entities collected by func itself (e.g. by patching) are kept for the next drain \
+         *          the filter is checked right before each call, so it sees the Components at drain time
+         *
+         * @tparam Func function type, takes Entity
+         * @param func function object to be executed
+         */
+        template <typename Func>
+        void each(Func func)
+        {
+            mDraining.assign(mCollected.getDenseEntities().begin(), mCollected.getDenseEntities().end());
+            mCollected.clear();
+
+            for (const Entity entity : mDraining)
+            {
+                if ((mpRequired && !mpRequired(mRegistry, entity)) || (mpExcluded && mpExcluded(mRegistry, entity)))
+                {
+                    continue;
+                }
+
+                func(entity);
+            }
+        }
+
+        /**
+         * @brief  discard all collected Entities
+         *
+         */
+        void clear()
+        {
+            mCollected.clear();
+        }
+
+    private:
+        //! tag type of the set of collected Entities
+        struct Collected
+        {
+        };
+
+        /**
+         * @brief  connect to the signal (at most once)
+         *
+         * @param signal signal to be observed
+         */
+        void connect(Signal& signal)
+        {
+            if (std::find(mpSignals.begin(), mpSignals.end(), &signal) != mpSignals.end())
+            {
+                return;
+            }
+
+            signal.connect(this, &Observer::collect);
+            mpSignals.emplace_back(&signal);
+        }
+
+        /**
+         * @brief  listener of the observed signals
+         * @details if an older generation of the same entity index is still collected (destroyed and recycled before the drain), it is replaced in place
+         *
+         */
+        static void collect(void* const pInstance, const Entity entity)
+        {
+            SparseSet<Collected>& collected = static_cast<Observer*>(pInstance)->mCollected;
+            const Entity held               = collected.getEntityByIndex(static_cast<std::size_t>(entity & kEntityIndexMask));
+
+            if (held == kInvalidEntity)
+            {
+                collected.emplace(entity);
+            }
+            else if (held != entity)
+            {
+                collected.rebind(entity);
+            }
+        }
+
+        //! observed Registry
+        Registry& mRegistry;
+        //! collected Entities, deduplicated by the sparse set
+        SparseSet<Collected> mCollected;
+        //! Entities being drained by each() (kept to reuse its capacity)
+        std::pmr::vector<Entity> mDraining;
+        //! connected signals
+        std::pmr::vector<Signal*> mpSignals;
+        //! checks if the Entity has all of the Component types given to where() (nullptr if not set)
+        bool (*mpRequired)(Registry&, Entity);
+        //! checks if the Entity has any of the Component types given to exclude() (nullptr if not set)
+        bool (*mpExcluded)(Registry&, Entity);
+    };
+}  // namespace ec2s
+
+#endif
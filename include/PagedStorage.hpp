@@ -0,0 +1,216 @@
+/*****************************************************************//**
+ * @file   PagedStorage.hpp
+ * @brief  header file of PagedStorage class
+ * 
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_PAGEDSTORAGE_HPP_
+#define EC2S_PAGEDSTORAGE_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <vector>
+#include <cassert>
+
+namespace ec2s
+{
+    /**
+     * @brief  vector-like container that stores elements in fixed-size pages
+     * @details growth never moves existing elements, so references and pointers to elements stay valid until they are removed
+     * 
+     * @tparam T element type
+     * @tparam kPageSize number of elements stored in one page (power of two)
+     */
+    template <typename T, std::size_t kPageSize>
+    class PagedStorage
+    {
+        static_assert(kPageSize > 0 && (kPageSize & (kPageSize - 1)) == 0, "page size must be a power of two!");
+
+    public:
+        //! minimum alignment of the head of each page
+        constexpr static std::size_t kAlignment = 64;
+
+    private:
+        /**
+         * @brief  uninitialized memory area for kPageSize elements (aligned to kAlignment so that runs in a page can be loaded by aligned SIMD instructions)
+         */
+        struct Page
+        {
+            alignas(T) alignas(kAlignment) std::byte memory[sizeof(T) * kPageSize];
+        };
+
+    public:
+        /** 
+         * @brief  constructor
+         *  
+         * @param pMemoryResource memory resource from which pages are allocated
+         */
+        explicit PagedStorage(std::pmr::memory_resource* const pMemoryResource = std::pmr::get_default_resource())
+            : mPages(pMemoryResource)
+            , mSize(0)
+        {
+        }
+
+        /** 
+         * @brief  copy constructor (copies all elements, allocated from the same memory resource as the other)
+         *  
+         * @param other storage to be copied
+         */
+        PagedStorage(const PagedStorage& other)
+            : mPages(other.mPages.get_allocator())
+            , mSize(0)
+        {
+            reserve(other.mSize);
+            for (std::size_t i = 0; i < other.mSize; ++i)
+            {
+                emplace_back(other[i]);
+            }
+        }
+
+        /** 
+         * @brief  move constructor (moves pages without touching elements)
+         *  
+         * @param other storage to be moved
+         */
+        PagedStorage(PagedStorage&& other) noexcept
+            : mPages(std::move(other.mPages))
+            , mSize(other.mSize)
+        {
+            other.mSize = 0;
+        }
+
+        PagedStorage& operator=(const PagedStorage&) = delete;
+        PagedStorage& operator=(PagedStorage&&)      = delete;
+
+        /** 
+         * @brief  destructor
+         *  
+         */
+        ~PagedStorage()
+        {
+            clear();
+
+            for (Page* pPage : mPages)
+            {
+                mPages.get_allocator().template deallocate_object<Page>(pPage);
+            }
+        }
+
+        /** 
+         * @brief  constructs an element at the end (allocates a new page only if the last page is full)
+         *  
+         * @tparam Args types of arguments forwarded to the element constructor
+         * @param ...args arguments forwarded to the element constructor
+         * @return reference to the constructed element
+         */
+        template <typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (mSize == mPages.size() * kPageSize)
+            {
+                mPages.emplace_back(mPages.get_allocator().template allocate_object<Page>());
+            }
+
+            T* p = new (mPages[mSize / kPageSize]->memory + sizeof(T) * (mSize & (kPageSize - 1))) T(std::forward<Args>(args)...);
+            ++mSize;
+
+            return *p;
+        }
+
+        /** 
+         * @brief  destruct the last element
+         *  
+         */
+        void pop_back()
+        {
+            assert(mSize > 0 || !"pop_back() on empty PagedStorage!");
+            back().~T();
+            --mSize;
+        }
+
+        /** 
+         * @brief  destruct all elements (allocated pages are retained)
+         *  
+         */
+        void clear()
+        {
+            while (mSize > 0)
+            {
+                pop_back();
+            }
+        }
+
+        /** 
+         * @brief  allocate pages so that reserveSize elements can be stored without allocation
+         *  
+         * @param reserveSize number of elements
+         */
+        void reserve(const std::size_t reserveSize)
+        {
+            while (mPages.size() * kPageSize < reserveSize)
+            {
+                mPages.emplace_back(mPages.get_allocator().template allocate_object<Page>());
+            }
+        }
+
+        /** 
+         * @brief  returns the number of elements
+         *  
+         * @return size
+         */
+        std::size_t size() const
+        {
+            return mSize;
+        }
+
+        /** 
+         * @brief  returns whether there is no element
+         *  
+         */
+        bool empty() const
+        {
+            return mSize == 0;
+        }
+
+        /** 
+         * @brief  operator overload for index access to element
+         *  
+         * @param index index of the element
+         * @return reference to the element
+         */
+        T& operator[](const std::size_t index)
+        {
+            return *std::launder(reinterpret_cast<T*>(mPages[index / kPageSize]->memory + sizeof(T) * (index & (kPageSize - 1))));
+        }
+
+        /** 
+         * @brief  operator overload for index access to element (const ver)
+         *  
+         * @param index index of the element
+         * @return const reference to the element
+         */
+        const T& operator[](const std::size_t index) const
+        {
+            return *std::launder(reinterpret_cast<const T*>(mPages[index / kPageSize]->memory + sizeof(T) * (index & (kPageSize - 1))));
+        }
+
+        /** 
+         * @brief  reference to the last element
+         *  
+         */
+        T& back()
+        {
+            return (*this)[mSize - 1];
+        }
+
+    private:
+        //! allocated pages (never relocated)
+        std::pmr::vector<Page*> mPages;
+        //! number of constructed elements
+        std::size_t mSize;
+    };
+}  // namespace ec2s
+
+#endif
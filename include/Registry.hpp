@@ -10,11 +10,20 @@
 
 #include "SparseSet.hpp"
 #include "View.hpp"
+#include "RuntimeView.hpp"
+#include "Group.hpp"
 #include "Entity.hpp"
 #include "StackAny.hpp"
 
-#include <unordered_map>
-#include <queue>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <memory_resource>
+#include <span>
+#include <stdexcept>
+#include <utility>
 #include <cassert>
 
 #ifndef NDEBUG
@@ -32,9 +41,21 @@ namespace ec2s
         /** 
          * @brief  constructor
          *  
+         * @param pMemoryResource memory resource from which every SparseSet, the Entity array, the signatures and the SparseSet map are allocated \
+         *                        (e.g. std::pmr::monotonic_buffer_resource as a per-level arena, must outlive this Registry)
          */
-        Registry()
-            : mNextEntity(0)
+        explicit Registry(std::pmr::memory_resource* const pMemoryResource = std::pmr::get_default_resource())
+            : mpMemoryResource(pMemoryResource)
+            , mEntities(pMemoryResource)
+            , mFreeHead(kNullEntityIndex)
+            , mFreeNum(0)
+            , mCurrentTick(1)
+            , mSignatureWordNum(1)
+            , mSignatures(pMemoryResource)
+            , mpSparseSets(pMemoryResource)
+            , mComponentArrays(pMemoryResource)
+            , mpComponentArrayPairs(pMemoryResource)
+            , mpGroups(pMemoryResource)
         {
         }
 
@@ -57,14 +78,19 @@ namespace ec2s
         {
             Entity rtn = 0;
 
-            if (mFreedEntities.empty())
+            if (mFreeHead == kNullEntityIndex)
             {
-                rtn = mNextEntity++;
+                rtn = static_cast<Entity>(mEntities.size());
+                mEntities.emplace_back(rtn);
             }
             else
             {
-                rtn = mFreedEntities.front();
-                mFreedEntities.pop();
+                // pop the head of the implicit freelist, the slot part already holds the next generation
+                const Entity index = mFreeHead;
+                mFreeHead          = mEntities[index] & kEntityIndexMask;
+                rtn                = (mEntities[index] & kEntitySlotMask) | index;
+                mEntities[index]   = rtn;
+                --mFreeNum;
             }
 
             if constexpr (sizeof...(Args) > 0)
@@ -76,22 +102,105 @@ namespace ec2s
         }
 
         /** 
-         * @brief  destroy specified Entity
+         * @brief  checks if the specified Entity has been created and not destroyed yet (stale handles are invalid)
+         *  
+         * @param entity Entity to be checked
+         * @return whether the Entity is valid
+         */
+        bool valid(const Entity entity) const
+        {
+            const auto index = static_cast<std::size_t>(entity & kEntityIndexMask);
+            return index < mEntities.size() && mEntities[index] == entity;
+        }
+
+        /** 
+         * @brief  destroy specified Entity (does nothing for invalid Entities)
+         * @details only the SparseSets recorded in the signature of the Entity are visited
          *  
          * @param entity Entity to be destroyed
          */
         void destroy(const Entity entity)
         {
-            for (auto& [typeHash, pSparseSet] : mpComponentArrayPairs)
+            if (!valid(entity))
             {
-                pSparseSet->remove(entity);
+                return;
+            }
+
+            if (std::uint64_t* const pSignature = findSignature(entity))
+            {
+                for (std::size_t word = 0; word < mSignatureWordNum; ++word)
+                {
+                    for (std::uint64_t bits = pSignature[word]; bits != 0; bits &= bits - 1)
+                    {
+                        mpSparseSets[word * kSignatureWordBits + std::countr_zero(bits)]->remove(entity);
+                    }
+                    pSignature[word] = 0;
+                }
             }
 
-            mFreedEntities.emplace(static_cast<Entity>(entity | (1ull << kEntitySlotShiftWidth)));
+            release(entity);
+        }
+
+        /** 
+         * @brief  destroy all Entities in [first, last) (invalid Entities are ignored)
+         * @details each SparseSet marks the victims and is compacted in one linear pass \
+         *          as with destroy(entity), the Components are removed before the Entities are released, so onDestroy() listeners still see them valid
+         *  
+         * @tparam EntityItr forward iterator type of Entities
+         * @param first first Entity
+         * @param last end of Entities
+         */
+        template <typename EntityItr>
+        void destroy(EntityItr first, EntityItr last)
+        {
+            // only the SparseSets owned by at least one of the victims are visited
+            std::pmr::vector<std::uint64_t> owned(mSignatureWordNum, 0, mpMemoryResource);
+            for (auto itr = first; itr != last; ++itr)
+            {
+                if (!valid(*itr))
+                {
+                    continue;
+                }
+
+                if (const std::uint64_t* const pSignature = findSignature(*itr))
+                {
+                    for (std::size_t word = 0; word < mSignatureWordNum; ++word)
+                    {
+                        owned[word] |= pSignature[word];
+                    }
+                }
+            }
+
+            // pools hold only the current generation, so stale (already destroyed) handles are not removed
+            for (std::size_t word = 0; word < mSignatureWordNum; ++word)
+            {
+                for (std::uint64_t bits = owned[word]; bits != 0; bits &= bits - 1)
+                {
+                    mpSparseSets[word * kSignatureWordBits + std::countr_zero(bits)]->remove(first, last);
+                }
+            }
+
+            // signatures are cleared only now so that onDestroy() listeners of every pool still see the victims' Components,
+            // and duplicated handles are released only once, since the first release invalidates the rest
+            for (; first != last; ++first)
+            {
+                if (!valid(*first))
+                {
+                    continue;
+                }
+
+                if (std::uint64_t* const pSignature = findSignature(*first))
+                {
+                    std::fill_n(pSignature, mSignatureWordNum, 0);
+                }
+
+                release(*first);
+            }
         }
 
         /** 
          * @brief  clear all entities
+         * @details every alive Entity is released, so that handles obtained before remain invalid
          *  
          */
         void clear()
@@ -101,31 +210,134 @@ namespace ec2s
                 pSparseSet->clear();
             }
 
-            std::queue<Entity> empty;
-            std::swap(mFreedEntities, empty);
+            mSignatures.clear();
+
+            for (std::size_t index = 0; index < mEntities.size(); ++index)
+            {
+                if ((mEntities[index] & kEntityIndexMask) == index)
+                {
+                    release(mEntities[index]);
+                }
+            }
         }
 
         /** 
          * @brief  obtains the reference of specified Component of the specified Entity
+         * @details this is mutable access, so the changed tick is stamped if the Component type keeps ticks (read through the const overload to avoid it)
          *  
          * @param entity Entity to get Component
          * @return ntity to get Component
          */
         template <typename Component>
-        Component& get(const Entity entity)
+        Traits::ReferenceOf<Component> get(const Entity entity)
         {
-            return mComponentArrayMap[TypeHasher::hash<Component>()].get<SparseSet<Component>>()[entity];
+            return getSparseSet<Component>()[entity];
+        }
+
+        /** 
+         * @brief  obtains the const reference of specified Component of the specified Entity (never stamps the changed tick, e.g. std::as_const(registry).get<T>(entity))
+         *  
+         * @param entity Entity to get Component
+         * @return const reference to the Component
+         */
+        template <typename Component>
+        Traits::ConstReferenceOf<Component> get(const Entity entity) const
+        {
+            return getSparseSet<Component>()[entity];
+        }
+
+        /** 
+         * @brief  modifies the specified Component of the specified Entity in place and notifies the update (the explicit update path for Observer)
+         *  
+         * @tparam Component component type
+         * @tparam Func function type, takes the reference of the Component
+         * @param entity Entity whose Component is modified
+         * @param func function modifying the Component
+         * @return reference to the Component
+         */
+        template <typename Component, typename Func>
+        Traits::ReferenceOf<Component> patch(const Entity entity, Func func)
+        {
+            return getSparseSet<Component>().patch(entity, func);
+        }
+
+        /** 
+         * @brief  signal published after the specified Component is added to an Entity which did not have it
+         *  
+         * @tparam T component type
+         * @return reference to the signal
+         */
+        template <typename T>
+        Signal& onConstruct()
+        {
+            return getSparseSet<T>(assureComponentIndex<T>()).onConstruct();
+        }
+
+        /** 
+         * @brief  signal published after the specified Component is replaced (by add) or patched
+         *  
+         * @tparam T component type
+         * @return reference to the signal
+         */
+        template <typename T>
+        Signal& onUpdate()
+        {
+            return getSparseSet<T>(assureComponentIndex<T>()).onUpdate();
+        }
+
+        /** 
+         * @brief  signal published before the specified Component is removed (including destroy and clear)
+         *  
+         * @tparam T component type
+         * @return reference to the signal
+         */
+        template <typename T>
+        Signal& onDestroy()
+        {
+            return getSparseSet<T>(assureComponentIndex<T>()).onDestroy();
         }
 
         /** 
          * @brief  obtains all Entities with the specified Component
+         * @details for Component types removed in place (Traits::ComponentTraits::kInPlaceDelete), \
+         *          removed Entities remain as ISparseSet::kTombstoneEntity until compaction, so callers must skip them
          *  
-         * @return 
+         * @return DenseEntities of the SparseSet of the Component
          */
         template <typename T>
-        const std::vector<Entity>& getEntities()
+        const std::pmr::vector<Entity>& getEntities()
         {
-            return mComponentArrayMap[TypeHasher::hash<T>()].get<SparseSet<T>>().getDenseEntities();
+            return getSparseSet<T>().getDenseEntities();
+        }
+
+        /** 
+         * @brief  get the current tick, stamped to the Components added or changed from now on
+         *  
+         * @return current tick
+         */
+        Tick getTick() const
+        {
+            return mCurrentTick;
+        }
+
+        /** 
+         * @brief  close the current tick and advance to the next one, called by each system at the end of its run (not once per frame)
+         * @details the system keeps the returned tick and passes it to View::since() on its next run to visit only Added<T> / Changed<T> Components: \
+         *          its own writes carry the closed tick and are not visited again, while anything stamped after it returned carries a later tick \
+         *          and is visited, even if written in the same frame by a system running after it \
+         *          e.g. registry.view<Changed<T>>().since(mLastRun).each(...); mLastRun = registry.advanceTick();
+         *  
+         * @return the closed tick (last-run tick of the calling system)
+         */
+        Tick advanceTick()
+        {
+            const Tick closed = mCurrentTick++;
+            for (auto& [typeHash, pSparseSet] : mpComponentArrayPairs)
+            {
+                pSparseSet->setCurrentTick(mCurrentTick);
+            }
+
+            return closed;
         }
 
         /** 
@@ -135,7 +347,7 @@ namespace ec2s
          */
         std::size_t activeEntityNum() const
         {
-            return static_cast<std::size_t>(mNextEntity) - mFreedEntities.size();
+            return mEntities.size() - mFreeNum;
         }
 
         /** 
@@ -147,11 +359,8 @@ namespace ec2s
         template <typename T>
         std::size_t size()
         {
-            if (!mComponentArrayMap.contains(TypeHasher::hash<T>()))
-            {
-                return 0;
-            }
-            return mComponentArrayMap[TypeHasher::hash<T>()].get<SparseSet<T>>().size();
+            const SparseSet<T>* const pSparseSet = findSparseSet<T>();
+            return pSparseSet ? pSparseSet->size() : 0;
         }
 
         /** 
@@ -163,7 +372,23 @@ namespace ec2s
         template <typename T>
         bool contains(const Entity entity)
         {
-            return mComponentArrayMap.contains(TypeHasher::hash<T>()) && mComponentArrayMap[TypeHasher::hash<T>()].get<SparseSet<T>>().contains(entity);
+            const SparseSet<T>* const pSparseSet = findSparseSet<T>();
+            return pSparseSet && pSparseSet->contains(entity);
+        }
+
+        /** 
+         * @brief  checks if the specified Entity has all of the specified Components
+         * @details answered only by the signature of the Entity (no SparseSet is visited)
+         *  
+         * @tparam Args component types
+         * @param entity entity to be checked
+         * @return whether the entity has all of the Components
+         */
+        template <typename... Args>
+        bool containsAll(const Entity entity)
+        {
+            const std::uint64_t* const pSignature = valid(entity) ? findSignature(entity) : nullptr;
+            return pSignature && (hasSignatureBit<Args>(pSignature) && ...);
         }
 
         /** 
@@ -175,23 +400,80 @@ namespace ec2s
          * @param ...args arguments forwarded to the Component constructor
          */
         template <typename T, typename... Args>
-        void add(const Entity entity, Args... args)
+        void add(const Entity entity, Args&&... args)
         {
-#ifdef EC2S_CHECK_SYNONYM
-            const TypeHash hash = TypeHasher::hash<T>();
-#else
-            constexpr TypeHash hash = TypeHasher::hash<T>();
-#endif
+            const std::size_t componentIndex = assureComponentIndex<T>();
+            getSparseSet<T>(componentIndex).emplace(entity, std::forward<Args>(args)...);
+            setSignatureBit(entity, componentIndex);
+        }
 
-            auto&& itr = mComponentArrayMap.find(hash);
-            if (itr == mComponentArrayMap.end())
+        /** 
+         * @brief  add a copy of the value as the specified Component to every Entity in [first, last)
+         * @details the SparseSet is resolved and reserved only once
+         *  
+         * @tparam T component type
+         * @tparam EntityItr iterator type of Entities
+         * @param first first Entity
+         * @param last end of Entities
+         * @param value value to be copied to each Component
+         */
+        template <typename T, typename EntityItr>
+        void insert(EntityItr first, EntityItr last, const T& value)
+        {
+            const std::size_t componentIndex = assureComponentIndex<T>();
+            auto& ss                         = getSparseSet<T>(componentIndex);
+
+            if constexpr (std::forward_iterator<EntityItr>)
+            {
+                ss.insert(first, last, value);
+                for (; first != last; ++first)
+                {
+                    setSignatureBit(*first, componentIndex);
+                }
+            }
+            else
             {
-                itr = mComponentArrayMap.emplace(hash, SparseSet<T>()).first;
-                mpComponentArrayPairs.emplace_back(hash, &(itr->second.get<SparseSet<T>>()));
+                for (; first != last; ++first)
+                {
+                    ss.emplace(*first, value);
+                    setSignatureBit(*first, componentIndex);
+                }
             }
+        }
+
+        /** 
+         * @brief  add the values of [valueFirst, valueFirst + (last - first)) as the specified Component to the corresponding Entities in [first, last)
+         * @details the SparseSet is resolved and reserved only once
+         *  
+         * @tparam T component type
+         * @tparam EntityItr iterator type of Entities
+         * @tparam ValueItr iterator type of values
+         * @param first first Entity
+         * @param last end of Entities
+         * @param valueFirst first value
+         */
+        template <typename T, typename EntityItr, typename ValueItr, typename std::enable_if_t<std::input_iterator<ValueItr>>* = nullptr>
+        void insert(EntityItr first, EntityItr last, ValueItr valueFirst)
+        {
+            const std::size_t componentIndex = assureComponentIndex<T>();
+            auto& ss                         = getSparseSet<T>(componentIndex);
 
-            auto& ss = itr->second.get<SparseSet<T>>();
-            ss.emplace(entity, args...);
+            if constexpr (std::forward_iterator<EntityItr>)
+            {
+                ss.insert(first, last, valueFirst);
+                for (; first != last; ++first)
+                {
+                    setSignatureBit(*first, componentIndex);
+                }
+            }
+            else
+            {
+                for (; first != last; ++first, ++valueFirst)
+                {
+                    ss.emplace(*first, *valueFirst);
+                    setSignatureBit(*first, componentIndex);
+                }
+            }
         }
 
         /** 
@@ -203,20 +485,72 @@ namespace ec2s
         template <typename T>
         void remove(const Entity entity)
         {
-            auto&& itr = mComponentArrayMap.find(TypeHasher::hash<T>());
-            if (itr == mComponentArrayMap.end())
+            SparseSet<T>* const pSparseSet = findSparseSet<T>();
+            if (pSparseSet && pSparseSet->contains(entity))
+            {
+                pSparseSet->remove(entity);
+                resetSignatureBit(entity, TypeHasher::index<T>());
+            }
+        }
+
+        /** 
+         * @brief  removes a component of a specified type from all Entities in [first, last)
+         * @details the SparseSet marks the victims and is compacted in one linear pass
+         *  
+         * @tparam T component type
+         * @tparam EntityItr forward iterator type of Entities
+         * @param first first Entity
+         * @param last end of Entities
+         */
+        template <typename T, typename EntityItr>
+        void remove(EntityItr first, EntityItr last)
+        {
+            SparseSet<T>* const pSparseSet = findSparseSet<T>();
+            if (!pSparseSet)
             {
                 return;
             }
 
-            auto& ss = itr->second.get<SparseSet<T>>();
-            ss.remove(entity);
+            for (auto entity = first; entity != last; ++entity)
+            {
+                if (pSparseSet->contains(*entity))
+                {
+                    resetSignatureBit(*entity, TypeHasher::index<T>());
+                }
+            }
+            pSparseSet->remove(first, last);
         }
 
         /** 
-         * @brief  execute the specified function on all components of the specified type (system in ECS)
+         * @brief  sorts components of the specified type by the comparator
          *  
          * @tparam T component type
+         * @tparam Compare comparator type, compares two components (const T&) or two Entities
+         * @param compare comparator (strict weak ordering)
+         */
+        template <typename T, typename Compare>
+        void sort(Compare compare)
+        {
+            getSparseSet<T>(assureComponentIndex<T>()).sort(compare);
+        }
+
+        /** 
+         * @brief  reorders components of type T to follow the order of components of type Other
+         * @details after this, Views of T and Other iterate both arrays nearly sequentially
+         *  
+         * @tparam T component type to be sorted
+         * @tparam Other component type whose order is followed
+         */
+        template <typename T, typename Other>
+        void sort()
+        {
+            getSparseSet<T>(assureComponentIndex<T>()).sortAs(getSparseSet<Other>(assureComponentIndex<Other>()));
+        }
+
+        /** 
+         * @brief  execute the specified function on all components of the specified type (system in ECS)
+         *  
+         * @tparam T component type (const T only reads the components, which never stamps the changed ticks)
          * @tparam Func function type
          * @tparam IsEligibleEachFunc Trait to determine if the Func type is correctly callable for the specified Component type
          * @param func system function
@@ -224,14 +558,10 @@ namespace ec2s
         template <typename T, typename Func, typename Traits::IsEligibleEachFunc<Func, T>* = nullptr>
         void each(Func func)
         {
-            auto&& itr = mComponentArrayMap.find(TypeHasher::hash<T>());
-            if (itr == mComponentArrayMap.end())
+            if (auto* const pSparseSet = findAccessedSparseSet<T>())
             {
-                return;
+                pSparseSet->each(func);
             }
-
-            auto& ss = itr->second.get<SparseSet<T>>();
-            ss.each(func);
         }
 
         /** 
@@ -244,14 +574,10 @@ namespace ec2s
         template <typename T, typename Func, typename Traits::IsEligibleEachFunc<Func, Entity, T>* = nullptr>
         void each(Func func)
         {
-            auto&& itr = mComponentArrayMap.find(TypeHasher::hash<T>());
-            if (itr == mComponentArrayMap.end())
+            if (auto* const pSparseSet = findAccessedSparseSet<T>())
             {
-                return;
+                pSparseSet->each(func);
             }
-
-            auto& ss = itr->second.get<SparseSet<T>>();
-            ss.each(func);
         }
 
         /** 
@@ -259,10 +585,43 @@ namespace ec2s
          *  
          * @param func
          */
-        template <typename T, typename Func, typename std::enable_if_t<!std::is_invocable_v<Func, T&> && !std::is_invocable_v<Func, Entity, T&>>>
+        template <typename T, typename Func, typename std::enable_if_t<!std::is_invocable_v<Func, Traits::ReferenceOf<T>> && !std::is_invocable_v<Func, Entity, Traits::ReferenceOf<T>>>>
         void each(Func func)
         {
-            static_assert(std::is_invocable_v<Func, T&> || std::is_invocable_v<Func, Entity, T&>, "ineligible Func type!");
+            static_assert(std::is_invocable_v<Func, Traits::ReferenceOf<T>> || std::is_invocable_v<Func, Entity, Traits::ReferenceOf<T>>, "ineligible Func type!");
+        }
+
+        /** 
+         * @brief  execute the specified function on contiguous runs of the specified component type (for explicit SIMD kernels)
+         *  
+         * @tparam T component type (const T only reads the components, which never stamps the changed ticks)
+         * @tparam Func function type, takes SparseSet<T>::Chunk (std::span<T>, or the spans of each data member for SoA components), optionally preceded by std::span<const Entity>
+         * @param func system function
+         * @param chunkSize maximum number of elements per call
+         */
+        template <typename T, typename Func>
+        void eachChunk(Func func, const std::size_t chunkSize = SparseSet<std::remove_const_t<T>>::kDefaultChunkSize)
+        {
+            if (auto* const pSparseSet = findAccessedSparseSet<T>())
+            {
+                pSparseSet->eachChunk(func, chunkSize);
+            }
+        }
+
+        /** 
+         * @brief  execute the specified function once with spans over each data member array of the specified SoA component type
+         *  
+         * @tparam T component type stored as SoA (const T only reads the components, which never stamps the changed ticks)
+         * @tparam Func function type, takes std::span of each data member listed in the SoALayout (optionally preceded by std::span<const Entity>)
+         * @param func system function
+         */
+        template <typename T, typename Func>
+        void eachFields(Func func)
+        {
+            if (auto* const pSparseSet = findAccessedSparseSet<T>())
+            {
+                pSparseSet->eachFields(func);
+            }
         }
 
         /** 
@@ -277,8 +636,42 @@ namespace ec2s
             view<Component1, Component2, OtherComponents...>().each(func);
         }
 
+        /** 
+         * @brief  execute the specified function on all components of the specified type in parallel on the JobSystem (blocks until all finish)
+         * @details func is invoked concurrently from multiple threads, and the Registry must not be modified meanwhile
+         *  
+         * @tparam T component type
+         * @tparam Func function type, takes the component (optionally preceded by Entity)
+         * @param jobSystem JobSystem whose worker threads execute the ranges
+         * @param func system function
+         * @param grainSize maximum number of components per job
+         */
+        template <typename T, typename Func>
+        void parallelEach(JobSystem& jobSystem, Func func, const std::size_t grainSize = JobSystem::kDefaultGrainSize)
+        {
+            if (SparseSet<T>* const pSparseSet = findSparseSet<T>())
+            {
+                pSparseSet->parallelEach(jobSystem, func, grainSize);
+            }
+        }
+
+        /** 
+         * @brief  parallel each for multiple Component types
+         * @detail  create View internally
+         *  
+         * @param jobSystem JobSystem whose worker threads execute the ranges
+         * @param func system function
+         * @param grainSize maximum number of entities per job
+         */
+        template <typename Component1, typename Component2, typename... OtherComponents, typename Func>
+        void parallelEach(JobSystem& jobSystem, Func func, const std::size_t grainSize = JobSystem::kDefaultGrainSize)
+        {
+            view<Component1, Component2, OtherComponents...>().parallelEach(jobSystem, func, grainSize);
+        }
+
         /** 
          * @brief  create a View from specified component types
+         * @details wrap a component type in Optional<T> to receive T* (nullptr if absent) without filtering, e.g. registry.view<Sprite, Optional<Tint>>()
          *  
          * @tparam Args component types
          * @return created View
@@ -286,8 +679,75 @@ namespace ec2s
         template <typename... Args>
         View<Args...> view()
         {
-            checkAndAddNewComponent<Args...>();
-            return View<Args...>(mComponentArrayMap[TypeHasher::hash<Args>()].get<SparseSet<Args>>()...);
+            return View<Args...>(getSparseSet<Traits::ComponentOf<Args>>(assureComponentIndex<Traits::ComponentOf<Args>>())...);
+        }
+
+        /** 
+         * @brief  create a View from specified component types, skipping the entities which have any of the excluded component types
+         * @details the excluded SparseSets are resolved once here, e.g. registry.view<Position, Velocity>(exclude<Frozen>) \
+         *          at most View::kMaxExcludedNum (8) component types can be excluded, since the View holds them inline so that copying it never allocates \
+         *          (more fail to compile, exclude them through a RuntimeView instead)
+         *  
+         * @tparam Args component types
+         * @tparam ExcludedTypes component types which the entities must not have
+         * @return created View
+         */
+        template <typename... Args, typename... ExcludedTypes>
+        View<Args...> view(Exclude<ExcludedTypes...>)
+        {
+            static_assert(sizeof...(ExcludedTypes) <= View<Args...>::kMaxExcludedNum, "too many excluded Component types!");
+            return View<Args...>({ &getSparseSet<ExcludedTypes>(assureComponentIndex<ExcludedTypes>())... }, getSparseSet<Traits::ComponentOf<Args>>(assureComponentIndex<Traits::ComponentOf<Args>>())...);
+        }
+
+        /** 
+         * @brief  create a RuntimeView from Component types known only at runtime
+         * @details the SparseSets are resolved once here, an included type which has never been added matches nothing and an excluded one is ignored
+         *  
+         * @param includedTypeHashes TypeHash of the component types which the entities must have (order of RawComponents)
+         * @param excludedTypeHashes TypeHash of the component types which the entities must not have
+         * @return created RuntimeView
+         */
+        RuntimeView runtimeView(std::span<const TypeHash> includedTypeHashes, std::span<const TypeHash> excludedTypeHashes = {})
+        {
+            std::pmr::vector<ISparseSet*> pIncluded(mpMemoryResource);
+            pIncluded.reserve(includedTypeHashes.size());
+            for (const TypeHash hash : includedTypeHashes)
+            {
+                pIncluded.emplace_back(findSparseSet(hash));
+            }
+
+            std::pmr::vector<const ISparseSet*> pExcluded(mpMemoryResource);
+            for (const TypeHash hash : excludedTypeHashes)
+            {
+                if (const ISparseSet* const pSparseSet = findSparseSet(hash))
+                {
+                    pExcluded.emplace_back(pSparseSet);
+                }
+            }
+
+            return RuntimeView(std::move(pIncluded), std::pmr::vector<TypeHash>(includedTypeHashes.begin(), includedTypeHashes.end(), mpMemoryResource), std::move(pExcluded));
+        }
+
+        /** 
+         * @brief  declare (or obtain the already declared) owning Group of the specified component types
+         * @details from now on, add/remove/destroy keep the entities having all of them in the prefix of each owned SparseSet
+         *  
+         * @tparam Head first owned component type (each type can be owned by at most one Group, and owned types cannot be sorted)
+         * @tparam Tail subsequent owned component types
+         * @return reference to the Group
+         */
+        template <typename Head, typename... Tail>
+        Group<Head, Tail...>& group()
+        {
+            auto& head = getSparseSet<Head>(assureComponentIndex<Head>());
+            if (IGroup* pGroup = head.getOwningGroup())
+            {
+                assert((pGroup->getGroupTypeHash() == TypeHasher::hash<Group<Head, Tail...>>()) || !"component type is already owned by another group!");
+                return *static_cast<Group<Head, Tail...>*>(pGroup);
+            }
+
+            auto& pGroup = mpGroups.emplace_back(std::make_unique<Group<Head, Tail...>>(head, getSparseSet<Tail>(assureComponentIndex<Tail>())...));
+            return *static_cast<Group<Head, Tail...>*>(pGroup.get());
         }
 
         /** 
@@ -329,41 +789,270 @@ namespace ec2s
         }
 
         /** 
-         * @brief  check if there is a SparseSet of the specified Component type and if not, add it
+         * @brief  obtains the index of the SparseSet of the specified Component type, adding the SparseSet if there is none
+         * @details the index is TypeHasher::index<T>(), which is also the bit index in the signatures
          *  
+         * @tparam T component type
+         * @return index of the SparseSet
          */
-        template <typename Head, typename... Tail>
-        void checkAndAddNewComponent()
+        template <typename T>
+        std::size_t assureComponentIndex()
         {
+            const std::size_t componentIndex = TypeHasher::index<T>();
+            if (componentIndex < mpSparseSets.size() && mpSparseSets[componentIndex])
+            {
+                return componentIndex;
+            }
+
 #ifdef EC2S_CHECK_SYNONYM
-            const TypeHash hash = TypeHasher::hash<Head>();
+            const TypeHash hash = TypeHasher::hash<T>();
 #else
-            constexpr TypeHash hash = TypeHasher::hash<Head>();
+            constexpr TypeHash hash = TypeHasher::hash<T>();
 #endif
 
-            if (!mComponentArrayMap.contains(hash))
+            if (componentIndex >= mpSparseSets.size())
             {
-                auto&& itr = mComponentArrayMap.emplace(hash, SparseSet<Head>()).first;
-                mpComponentArrayPairs.emplace_back(hash, &(itr->second.get<SparseSet<Head>>()));
+                mpSparseSets.resize(componentIndex + 1, nullptr);
             }
 
-            if constexpr (sizeof...(Tail) > 0)
+            auto& ss                     = mComponentArrays.emplace_back(std::in_place_type<SparseSet<T>>, mpMemoryResource).template get<SparseSet<T>>();
+            mpSparseSets[componentIndex] = &ss;
+            mpComponentArrayPairs.emplace_back(hash, &ss);
+            ss.setCurrentTick(mCurrentTick);
+
+            while (componentIndex >= mSignatureWordNum * kSignatureWordBits)
+            {
+                growSignatures();
+            }
+
+            return componentIndex;
+        }
+
+        /** 
+         * @brief  obtains the SparseSet of the specified Component type by its index
+         *  
+         * @tparam T component type
+         * @param componentIndex index obtained from assureComponentIndex()
+         * @return reference to the SparseSet
+         */
+        template <typename T>
+        SparseSet<T>& getSparseSet(const std::size_t componentIndex)
+        {
+            return *static_cast<SparseSet<T>*>(mpSparseSets[componentIndex]);
+        }
+
+        /** 
+         * @brief  obtains the SparseSet of the specified Component type (throws std::out_of_range if no such Component has been added)
+         *  
+         * @tparam T component type
+         * @return reference to the SparseSet
+         */
+        template <typename T>
+        SparseSet<T>& getSparseSet()
+        {
+            return const_cast<SparseSet<T>&>(std::as_const(*this).template getSparseSet<T>());
+        }
+
+        /** 
+         * @brief  obtains the SparseSet of the specified Component type (const ver, throws std::out_of_range if no such Component has been added)
+         *  
+         * @tparam T component type
+         * @return const reference to the SparseSet
+         */
+        template <typename T>
+        const SparseSet<T>& getSparseSet() const
+        {
+            const SparseSet<T>* const pSparseSet = findSparseSet<T>();
+            if (!pSparseSet)
             {
-                checkAndAddNewComponent<Tail...>();
+                throw std::out_of_range("no SparseSet of the specified Component type (Registry)!");
             }
+
+            return *pSparseSet;
+        }
+
+        /** 
+         * @brief  obtains the SparseSet of the specified Component type if exists
+         *  
+         * @tparam T component type
+         * @return pointer to the SparseSet, nullptr if no such Component has been added
+         */
+        template <typename T>
+        SparseSet<T>* findSparseSet()
+        {
+            return const_cast<SparseSet<T>*>(std::as_const(*this).template findSparseSet<T>());
         }
 
-        //! Entity to be created next
-        Entity mNextEntity;
-        //! destroyed Entity
-        std::queue<Entity> mFreedEntities;
+        /** 
+         * @brief  obtains the SparseSet of the specified Component type if exists, as const if T is const (so that reads through it never stamp the changed ticks)
+         *  
+         * @tparam T component type, optionally const
+         * @return pointer to the SparseSet, nullptr if no such Component has been added
+         */
+        template <typename T>
+        std::conditional_t<std::is_const_v<T>, const SparseSet<std::remove_const_t<T>>*, SparseSet<T>*> findAccessedSparseSet()
+        {
+            return findSparseSet<std::remove_const_t<T>>();
+        }
+
+        /** 
+         * @brief  obtains the SparseSet of the specified Component type if exists (const ver)
+         *  
+         * @tparam T component type
+         * @return pointer to the SparseSet, nullptr if no such Component has been added
+         */
+        template <typename T>
+        const SparseSet<T>* findSparseSet() const
+        {
+            const std::size_t componentIndex = TypeHasher::index<T>();
+            return componentIndex < mpSparseSets.size() ? static_cast<const SparseSet<T>*>(mpSparseSets[componentIndex]) : nullptr;
+        }
+
+        /** 
+         * @brief  obtains the SparseSet of the Component type with the specified TypeHash if exists (linear search, for runtime queries)
+         *  
+         * @param hash TypeHash of the component type
+         * @return pointer to the SparseSet, nullptr if no such Component has been added
+         */
+        ISparseSet* findSparseSet(const TypeHash hash) const
+        {
+            for (const auto& [typeHash, pSparseSet] : mpComponentArrayPairs)
+            {
+                if (typeHash == hash)
+                {
+                    return pSparseSet;
+                }
+            }
+
+            return nullptr;
+        }
+
+        /** 
+         * @brief  pushes the slot of the specified (valid) Entity to the implicit freelist with its generation incremented
+         *  
+         * @param entity Entity to be released
+         */
+        void release(const Entity entity)
+        {
+            const Entity index = entity & kEntityIndexMask;
+            Entity nextSlot    = (entity & kEntitySlotMask) + (1ull << kEntitySlotShiftWidth);
+            if (nextSlot == kEntitySlotMask)
+            {
+                // the all-ones generation is reserved for kInvalidEntity, so wrap around
+                nextSlot = 0;
+            }
+
+            mEntities[index] = nextSlot | mFreeHead;
+            mFreeHead        = index;
+            ++mFreeNum;
+        }
+
+        /** 
+         * @brief  obtains the signature of the specified Entity if it has been recorded
+         *  
+         * @param entity Entity
+         * @return pointer to the first word of the signature, nullptr if nothing has been recorded
+         */
+        std::uint64_t* findSignature(const Entity entity)
+        {
+            const auto index = static_cast<std::size_t>(entity & kEntityIndexMask);
+            return (index + 1) * mSignatureWordNum <= mSignatures.size() ? mSignatures.data() + index * mSignatureWordNum : nullptr;
+        }
+
+        /** 
+         * @brief  sets the bit of the specified Component index in the signature of the specified Entity
+         *  
+         * @param entity Entity
+         * @param componentIndex index obtained from assureComponentIndex()
+         */
+        void setSignatureBit(const Entity entity, const std::size_t componentIndex)
+        {
+            const auto index = static_cast<std::size_t>(entity & kEntityIndexMask);
+            if ((index + 1) * mSignatureWordNum > mSignatures.size())
+            {
+                mSignatures.resize((index + 1) * mSignatureWordNum, 0);
+            }
+
+            mSignatures[index * mSignatureWordNum + componentIndex / kSignatureWordBits] |= 1ull << (componentIndex % kSignatureWordBits);
+        }
+
+        /** 
+         * @brief  resets the bit of the specified Component index in the signature of the specified Entity
+         *  
+         * @param entity Entity
+         * @param componentIndex index obtained from assureComponentIndex()
+         */
+        void resetSignatureBit(const Entity entity, const std::size_t componentIndex)
+        {
+            if (std::uint64_t* const pSignature = findSignature(entity))
+            {
+                pSignature[componentIndex / kSignatureWordBits] &= ~(1ull << (componentIndex % kSignatureWordBits));
+            }
+        }
+
+        /** 
+         * @brief  checks the bit of the specified Component type in the signature
+         *  
+         * @tparam T component type
+         * @param pSignature signature of an Entity
+         * @return whether the bit is set (false if no such Component has been added)
+         */
+        template <typename T>
+        bool hasSignatureBit(const std::uint64_t* const pSignature) const
+        {
+            const std::size_t componentIndex = TypeHasher::index<T>();
+            return componentIndex < mSignatureWordNum * kSignatureWordBits && (pSignature[componentIndex / kSignatureWordBits] >> (componentIndex % kSignatureWordBits) & 1) != 0;
+        }
+
+        /** 
+         * @brief  widens every signature by one word (called when a Component type index exceeds the current width)
+         *  
+         */
+        void growSignatures()
+        {
+            const std::size_t entityNum = mSignatures.size() / mSignatureWordNum;
+            std::pmr::vector<std::uint64_t> grown(entityNum * (mSignatureWordNum + 1), 0, mpMemoryResource);
+            for (std::size_t i = 0; i < entityNum; ++i)
+            {
+                std::copy_n(mSignatures.data() + i * mSignatureWordNum, mSignatureWordNum, grown.data() + i * (mSignatureWordNum + 1));
+            }
+
+            mSignatures.swap(grown);
+            ++mSignatureWordNum;
+        }
+
+        //! memory resource from which all containers are allocated
+        std::pmr::memory_resource* mpMemoryResource;
+        //! index part terminating the implicit freelist
+        constexpr static Entity kNullEntityIndex = kEntityIndexMask;
+        //! alive Entity at its index, or (next generation | index of the next free slot) for destroyed slots
+        std::pmr::vector<Entity> mEntities;
+        //! index of the first free slot of mEntities (kNullEntityIndex if none)
+        Entity mFreeHead;
+        //! number of free slots in mEntities
+        std::size_t mFreeNum;
+        //! tick stamped to the Components added or changed from now on
+        Tick mCurrentTick;
+
+        //! number of bits in a word of signature
+        constexpr static std::size_t kSignatureWordBits = 64;
+        //! number of words of each signature (grows with the number of Component types)
+        std::size_t mSignatureWordNum;
+        //! signature of each Entity (which Components it has, indexed by TypeHasher::index()), mSignatureWordNum words per Entity index
+        std::pmr::vector<std::uint64_t> mSignatures;
 
         //! Dummy type for calculating the size of SparseSet (meaningless)
         using Dummy_t = std::uint32_t;
-        //! maps a SparseSet for each Component type to the type hash of the Component type
-        std::unordered_map<TypeHash, StackAny<sizeof(SparseSet<Dummy_t>)>> mComponentArrayMap;
-        //! pair of SparseSet and Component type hash for each Component type (same as mComponentArrayMap)
-        std::vector<std::pair<TypeHash, ISparseSet*>> mpComponentArrayPairs;
+        //! size of the area that can hold a SparseSet of any storage (contiguous or paged)
+        constexpr static std::size_t kSparseSetMemSize = sizeof(SparseSet<Dummy_t>) - sizeof(SparseSet<Dummy_t>::Storage) + std::max(sizeof(SparseSet<Dummy_t>::Storage), sizeof(PagedStorage<Dummy_t, 1>));
+        //! SparseSet of each Component type indexed by TypeHasher::index() (nullptr for types not added to this Registry)
+        std::pmr::vector<ISparseSet*> mpSparseSets;
+        //! SparseSet for each Component type in order of addition (deque never moves the elements)
+        std::pmr::deque<StackAny<kSparseSetMemSize>> mComponentArrays;
+        //! pair of SparseSet and Component type hash for each Component type (same order as mComponentArrays)
+        std::pmr::vector<std::pair<TypeHash, ISparseSet*>> mpComponentArrayPairs;
+        //! declared owning Groups (destroyed before the SparseSets they own)
+        std::pmr::vector<std::unique_ptr<IGroup>> mpGroups;
     };
 }  // namespace ec2s
 
@@ -0,0 +1,276 @@
+/*****************************************************************//**
+ * @file   RuntimeView.hpp
+ * @brief  header file of RuntimeView class
+ *
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_RUNTIMEVIEW_HPP_
+#define EC2S_RUNTIMEVIEW_HPP_
+
+#include <cassert>
+#include <memory_resource>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "ISparseSet.hpp"
+#include "TypeHash.hpp"
+
+namespace ec2s
+{
+    /**
+     * @brief  View whose Component types are given at runtime as lists of TypeHash (for tooling and scripting layers)
+     * @details the SparseSets are resolved once when it is built, and like View the DenseEntities of the smallest included SparseSet are iterated \
+     *          the Components are passed as raw pointers together with their stride (size in bytes of one element), \
+     *          read only unless mutable access is asked for (RawComponents::getMutable(), or get<T>() with non-const T), which stamps the changed tick
+     */
+    class RuntimeView
+    {
+    public:
+        /**
+         * @brief  accessor to the raw Components of the current entity, in the order of the included TypeHash list
+         * @details the Components are read without stamping the changed ticks, only the mutable accessors stamp them
+         */
+        class RawComponents
+        {
+        public:
+            /**
+             * @brief  constructor
+             * @details user does not need to build this
+             * @param pSparseSets included SparseSets
+             * @param typeHashes TypeHash of each included SparseSet
+             * @param pComponents raw pointer to each Component of the current entity
+             * @param entity current entity
+             */
+            RawComponents(std::span<ISparseSet* const> pSparseSets, std::span<const TypeHash> typeHashes, std::span<const void* const> pComponents, const Entity entity)
+                : mpSparseSets(pSparseSets)
+                , mTypeHashes(typeHashes)
+                , mpComponents(pComponents)
+                , mEntity(entity)
+            {
+            }
+
+            /**
+             * @brief  returns the number of included Component types
+             */
+            std::size_t size() const
+            {
+                return mpComponents.size();
+            }
+
+            /**
+             * @brief  raw pointer to read the i-th Component (never stamps the changed tick)
+             * @return pointer to the Component, nullptr if it has no raw access (getStride(i) == 0)
+             */
+            const void* operator[](const std::size_t i) const
+            {
+                return mpComponents[i];
+            }
+
+            /**
+             * @brief  raw pointer to modify the i-th Component (stamps the changed tick if the Component type keeps ticks)
+             * @return pointer to the Component, nullptr if it has no raw access (getStride(i) == 0)
+             */
+            void* getMutable(const std::size_t i) const
+            {
+                return mpComponents[i] ? mpSparseSets[i]->getRaw(mEntity) : nullptr;
+            }
+
+            /**
+             * @brief  size in bytes of the i-th Component
+             * @return stride of the Component, 0 for empty types and structure-of-arrays
+             */
+            std::size_t getStride(const std::size_t i) const
+            {
+                return mpSparseSets[i]->getStride();
+            }
+
+            /**
+             * @brief  TypeHash of the i-th Component
+             */
+            TypeHash getTypeHash(const std::size_t i) const
+            {
+                return mTypeHashes[i];
+            }
+
+            /**
+             * @brief  typed access to the i-th Component (for the code which knows the type)
+             * @details const T reads the Component, non-const T is mutable access and stamps the changed tick like getMutable()
+             *
+             * @tparam T Component type (optionally const), must be the type of the i-th TypeHash
+             */
+            template<typename T>
+            T& get(const std::size_t i) const
+            {
+                assert(TypeHasher::hash<std::remove_const_t<T>>() == mTypeHashes[i] || !"invalid Component type!");
+                assert(mpComponents[i] || !"the Component type has no raw access!");
+
+                if constexpr (std::is_const_v<T>)
+                {
+                    return *static_cast<T*>(mpComponents[i]);
+                }
+                else
+                {
+                    return *static_cast<T*>(getMutable(i));
+                }
+            }
+
+        private:
+            //! included SparseSets
+            std::span<ISparseSet* const> mpSparseSets;
+            //! TypeHash of each included SparseSet
+            std::span<const TypeHash> mTypeHashes;
+            //! raw pointer to each Component of the current entity
+            std::span<const void* const> mpComponents;
+            //! current entity
+            Entity mEntity;
+        };
+
+        /**
+         * @brief  constructor
+         * @details user does not need to build this (see Registry::runtimeView())
+         * @param pIncluded SparseSets which the entities must have (nullptr for a Component type that has never been added, which matches nothing)
+         * @param includedTypeHashes TypeHash of each included SparseSet
+         * @param pExcluded SparseSets which the entities must not have
+         */
+        RuntimeView(std::pmr::vector<ISparseSet*>&& pIncluded, std::pmr::vector<TypeHash>&& includedTypeHashes, std::pmr::vector<const ISparseSet*>&& pExcluded)
+            : mpIncluded(std::move(pIncluded))
+            , mIncludedTypeHashes(std::move(includedTypeHashes))
+            , mpExcluded(std::move(pExcluded))
+            , mpPivot(nullptr)
+        {
+            assert(mpIncluded.size() == mIncludedTypeHashes.size() || !"invalid TypeHash list!");
+
+            for (ISparseSet* const pSparseSet : mpIncluded)
+            {
+                if (!pSparseSet)
+                {
+                    mpPivot = nullptr;
+                    break;
+                }
+
+                if (!mpPivot || pSparseSet->size() < mpPivot->size())
+                {
+                    mpPivot = pSparseSet;
+                }
+            }
+        }
+
+        /**
+         * @brief  returns the number of elements in the included SparseSet with the lowest number of elements
+         * @details i.e., each() is executed at most this many times
+         */
+        std::size_t getMinSize() const
+        {
+            return mpPivot ? mpPivot->size() : 0;
+        }
+
+        /**
+         * @brief  checks if the entity has all of the included Components and none of the excluded ones
+         *
+         * @param entity entity to be checked
+         */
+        bool contains(const Entity entity) const
+        {
+            if (!mpPivot)
+            {
+                return false;
+            }
+
+            for (const ISparseSet* const pSparseSet : mpIncluded)
+            {
+                if (!pSparseSet->contains(entity))
+                {
+                    return false;
+                }
+            }
+
+            return !excludes(entity);
+        }
+
+        /**
+         * @brief  execute func on all matching entities
+         * @tparam Func type of func (to be inferred), takes Entity and const RawComponents&
+         * @param func function object to be executed, lambda expression, etc.
+         */
+        template<typename Func>
+        void each(Func func)
+        {
+            if (!mpPivot)
+            {
+                return;
+            }
+
+            std::pmr::vector<const void*> pComponents(mpIncluded.size(), nullptr, mpIncluded.get_allocator());
+
+            for (const Entity entity : mpPivot->getDenseEntities())
+            {
+                if (entity == ISparseSet::kTombstoneEntity || !collect(entity, pComponents) || excludes(entity))
+                {
+                    continue;
+                }
+
+                func(entity, RawComponents(mpIncluded, mIncludedTypeHashes, pComponents, entity));
+            }
+        }
+
+    private:
+        /**
+         * @brief  gets the raw pointers to read the included Components of the entity (never stamps the changed ticks)
+         *
+         * @param entity entity whose Components are obtained
+         * @param pComponents_out raw pointer to each Component
+         * @return whether the entity has all of the included Components
+         */
+        bool collect(const Entity entity, std::pmr::vector<const void*>& pComponents_out) const
+        {
+            for (std::size_t i = 0; i < mpIncluded.size(); ++i)
+            {
+                const ISparseSet* const pSparseSet = mpIncluded[i];
+
+                // getRaw() already tells absence unless the Component type has no raw access
+                if (pSparseSet->getStride() == 0)
+                {
+                    if (!pSparseSet->contains(entity))
+                    {
+                        return false;
+                    }
+                }
+                else if (!(pComponents_out[i] = pSparseSet->getRaw(entity)))
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief  checks if the entity has any of the excluded Components
+         */
+        bool excludes(const Entity entity) const
+        {
+            for (const ISparseSet* const pSparseSet : mpExcluded)
+            {
+                if (pSparseSet->contains(entity))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        //! SparseSets which the entities must have
+        std::pmr::vector<ISparseSet*> mpIncluded;
+        //! TypeHash of each included SparseSet
+        std::pmr::vector<TypeHash> mIncludedTypeHashes;
+        //! SparseSets which the entities must not have
+        std::pmr::vector<const ISparseSet*> mpExcluded;
+        //! smallest included SparseSet whose DenseEntities are iterated (nullptr if nothing can match)
+        ISparseSet* mpPivot;
+    };
+}  // namespace ec2s
+
+#endif
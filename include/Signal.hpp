@@ -0,0 +1,146 @@
+/*****************************************************************//**
+ * @file   Signal.hpp
+ * @brief  header file of Signal class
+ *
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_SIGNAL_HPP_
+#define EC2S_SIGNAL_HPP_
+
+#include <memory_resource>
+#include <vector>
+
+#include "Entity.hpp"
+
+namespace ec2s
+{
+    /**
+     * @brief  list of listeners notified with an Entity (construct/update/destroy events of a SparseSet)
+     * @details listeners are plain function pointers bound to an instance pointer, so connecting and publishing never allocate per event \
+     *          publishing costs only a size check while nothing is connected \
+     *          listeners may connect and disconnect (also themselves) while being published: \
+     *          listeners connected meanwhile are called from the next publish, and disconnected ones are no longer called and erased afterwards
+     */
+    class Signal
+    {
+    public:
+        //! type of the function called on publish, receives the instance pointer given to connect() and the Entity
+        using Listener = void (*)(void* const pInstance, const Entity entity);
+
+        /**
+         * @brief  constructor
+         *
+         * @param pMemoryResource memory resource from which the listener list is allocated
+         */
+        explicit Signal(std::pmr::memory_resource* const pMemoryResource = std::pmr::get_default_resource())
+            : mConnections(pMemoryResource)
+            , mPublishDepth(0)
+            , mDisconnectedNum(0)
+        {
+        }
+
+        /**
+         * @brief  connect a listener
+         *
+         * @param pInstance instance pointer passed to the listener (also the key for disconnect())
+         * @param listener function called on publish
+         */
+        void connect(void* const pInstance, const Listener listener)
+        {
+            mConnections.emplace_back(pInstance, listener);
+        }
+
+        /**
+         * @brief  disconnect all listeners bound to the instance pointer
+         *
+         * @param pInstance instance pointer given to connect()
+         */
+        void disconnect(const void* const pInstance)
+        {
+            if (mPublishDepth == 0)
+            {
+                std::erase_if(mConnections, [pInstance](const Connection& connection) { return connection.pInstance == pInstance; });
+                return;
+            }
+
+            // being published, so the connections are only marked (erasing would shift the ones not called yet)
+            for (Connection& connection : mConnections)
+            {
+                if (connection.pInstance == pInstance && connection.listener)
+                {
+                    connection.listener = nullptr;
+                    ++mDisconnectedNum;
+                }
+            }
+        }
+
+        /**
+         * @brief  call all listeners with the Entity
+         *
+         * @param entity Entity of the event
+         */
+        void publish(const Entity entity)
+        {
+            if (mConnections.empty())
+            {
+                return;
+            }
+
+            ++mPublishDepth;
+
+            // indexed (not iterated) since listeners may connect and reallocate, the ones appended meanwhile are not called
+            const std::size_t connectionNum = mConnections.size();
+            for (std::size_t i = 0; i < connectionNum; ++i)
+            {
+                const Connection connection = mConnections[i];
+                if (connection.listener)
+                {
+                    connection.listener(connection.pInstance, entity);
+                }
+            }
+
+            if (--mPublishDepth == 0 && mDisconnectedNum > 0)
+            {
+                std::erase_if(mConnections, [](const Connection& connection) { return !connection.listener; });
+                mDisconnectedNum = 0;
+            }
+        }
+
+        /**
+         * @brief  checks if no listener is connected
+         *
+         */
+        bool empty() const
+        {
+            return mConnections.size() == mDisconnectedNum;
+        }
+
+    private:
+        /**
+         * @brief  a listener with its instance pointer
+         */
+        struct Connection
+        {
+            Connection(void* const pInstance, const Listener listener)
+                : pInstance(pInstance)
+                , listener(listener)
+            {
+            }
+
+            //! instance pointer passed to the listener
+            void* pInstance;
+            //! function called on publish
+            Listener listener;
+        };
+
+        //! connected listeners (listener is nullptr if disconnected while being published)
+        std::pmr::vector<Connection> mConnections;
+        //! number of publish() calls in progress (nested if a listener publishes again)
+        std::size_t mPublishDepth;
+        //! number of connections marked as disconnected while being published
+        std::size_t mDisconnectedNum;
+    };
+}  // namespace ec2s
+
+#endif
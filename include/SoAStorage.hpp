@@ -0,0 +1,375 @@
+/*****************************************************************//**
+ * @file   SoAStorage.hpp
+ * @brief  header file of SoAStorage class
+ * 
+ * @author ichi-raven
+ * @date   November 2024
+ *********************************************************************/
+#ifndef EC2S_SOASTORAGE_HPP_
+#define EC2S_SOASTORAGE_HPP_
+
+#include <cstddef>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <cassert>
+
+#include "Traits.hpp"
+
+namespace ec2s
+{
+    template <typename T, typename Layout>
+    class SoAStorage;
+
+    /**
+     * @brief  vector-like container that stores each data member of T in its own aligned contiguous array (structure-of-arrays)
+     * @details all arrays share one allocation, element access returns a tuple of references to the data members
+     * 
+     * @tparam T element type
+     * @tparam Members pointers to all data members of T
+     */
+    template <typename T, auto... Members>
+    class SoAStorage<T, Traits::SoALayout<Members...>>
+    {
+    public:
+        //! alignment of the head of each data member array
+        constexpr static std::size_t kAlignment = 64;
+        //! tuple of references to the data members of one element
+        using Reference = std::tuple<typename Traits::MemberPointerTraits<decltype(Members)>::FieldType&...>;
+        //! tuple of const references to the data members of one element
+        using ConstReference = std::tuple<const typename Traits::MemberPointerTraits<decltype(Members)>::FieldType&...>;
+        //! tuple of spans over each data member array
+        using Spans = Traits::ChunkOf<T>;
+        //! tuple of spans over each const data member array
+        using ConstSpans = Traits::ConstChunkOf<T>;
+
+    private:
+        //! number of data members
+        constexpr static std::size_t kFieldNum = sizeof...(Members);
+        //! pointers to the data members
+        constexpr static std::tuple kMembers = std::make_tuple(Members...);
+
+        //! type of the I-th data member
+        template <std::size_t I>
+        using FieldAt = std::tuple_element_t<I, std::tuple<typename Traits::MemberPointerTraits<decltype(Members)>::FieldType...>>;
+
+        static_assert(kFieldNum > 0, "SoALayout must list at least one data member!");
+        static_assert(((alignof(typename Traits::MemberPointerTraits<decltype(Members)>::FieldType) <= kAlignment) && ...), "data member is over-aligned!");
+
+    public:
+        /** 
+         * @brief  constructor
+         *  
+         * @param pMemoryResource memory resource from which the arrays are allocated
+         */
+        explicit SoAStorage(std::pmr::memory_resource* const pMemoryResource = std::pmr::get_default_resource())
+            : mpMemoryResource(pMemoryResource)
+            , mpMemory(nullptr)
+            , mSize(0)
+            , mCapacity(0)
+        {
+        }
+
+        /** 
+         * @brief  copy constructor (copies all elements, allocated from the same memory resource as the other)
+         *  
+         * @param other storage to be copied
+         */
+        SoAStorage(const SoAStorage& other)
+            : SoAStorage(other.mpMemoryResource)
+        {
+            reserve(other.mSize);
+            forEachField([&]<std::size_t I>()
+                         {
+                             for (std::size_t i = 0; i < other.mSize; ++i)
+                             {
+                                 new (column<I>() + i) FieldAt<I>(other.template column<I>()[i]);
+                             }
+                         });
+            mSize = other.mSize;
+        }
+
+        /** 
+         * @brief  move constructor (moves the allocation without touching elements)
+         *  
+         * @param other storage to be moved
+         */
+        SoAStorage(SoAStorage&& other) noexcept
+            : mpMemoryResource(other.mpMemoryResource)
+            , mpMemory(std::exchange(other.mpMemory, nullptr))
+            , mSize(std::exchange(other.mSize, 0))
+            , mCapacity(std::exchange(other.mCapacity, 0))
+        {
+        }
+
+        SoAStorage& operator=(const SoAStorage&) = delete;
+        SoAStorage& operator=(SoAStorage&&)      = delete;
+
+        /** 
+         * @brief  destructor
+         *  
+         */
+        ~SoAStorage()
+        {
+            clear();
+            if (mpMemory)
+            {
+                mpMemoryResource->deallocate(mpMemory, allocationSize(mCapacity), kAlignment);
+            }
+        }
+
+        /** 
+         * @brief  constructs an element at the end and scatters its data members to each array
+         *  
+         * @tparam Args types of arguments forwarded to the element constructor
+         * @param ...args arguments forwarded to the element constructor
+         * @return references to the data members of the constructed element
+         */
+        template <typename... Args>
+        Reference emplace_back(Args&&... args)
+        {
+            if (mSize == mCapacity)
+            {
+                reserve(mCapacity == 0 ? 16 : mCapacity * 2);
+            }
+
+            T value(std::forward<Args>(args)...);
+            forEachField([&]<std::size_t I>() { new (column<I>() + mSize) FieldAt<I>(std::move(value.*std::get<I>(kMembers))); });
+
+            return (*this)[mSize++];
+        }
+
+        /** 
+         * @brief  replace the element at the index
+         *  
+         * @param index index of the element
+         * @param value new value
+         */
+        void assign(const std::size_t index, T&& value)
+        {
+            forEachField([&]<std::size_t I>() { column<I>()[index] = std::move(value.*std::get<I>(kMembers)); });
+        }
+
+        /** 
+         * @brief  move-assign the element at src to dst (src is left in the moved-from state)
+         *  
+         * @param dst index of the destination element
+         * @param src index of the source element
+         */
+        void moveElement(const std::size_t dst, const std::size_t src)
+        {
+            forEachField([&]<std::size_t I>() { column<I>()[dst] = std::move(column<I>()[src]); });
+        }
+
+        /** 
+         * @brief  swap two elements
+         *  
+         * @param lhs index of the first element
+         * @param rhs index of the second element
+         */
+        void swapElements(const std::size_t lhs, const std::size_t rhs)
+        {
+            forEachField([&]<std::size_t I>() { std::swap(column<I>()[lhs], column<I>()[rhs]); });
+        }
+
+        /** 
+         * @brief  destruct the last element
+         *  
+         */
+        void pop_back()
+        {
+            assert(mSize > 0 || !"pop_back() on empty SoAStorage!");
+            --mSize;
+            forEachField([&]<std::size_t I>() { column<I>()[mSize].~FieldAt<I>(); });
+        }
+
+        /** 
+         * @brief  destruct all elements (the allocation is retained)
+         *  
+         */
+        void clear()
+        {
+            while (mSize > 0)
+            {
+                pop_back();
+            }
+        }
+
+        /** 
+         * @brief  reallocate all arrays so that reserveSize elements can be stored without allocation
+         *  
+         * @param reserveSize number of elements
+         */
+        void reserve(const std::size_t reserveSize)
+        {
+            if (reserveSize <= mCapacity)
+            {
+                return;
+            }
+
+            std::byte* pOldMemory       = mpMemory;
+            const std::size_t oldCapacity = mCapacity;
+
+            mpMemory  = static_cast<std::byte*>(mpMemoryResource->allocate(allocationSize(reserveSize), kAlignment));
+            mCapacity = reserveSize;
+
+            if (!pOldMemory)
+            {
+                return;
+            }
+
+            forEachField(
+                [&]<std::size_t I>()
+                {
+                    FieldAt<I>* pOld = reinterpret_cast<FieldAt<I>*>(pOldMemory + columnOffset<I>(oldCapacity));
+                    for (std::size_t i = 0; i < mSize; ++i)
+                    {
+                        new (column<I>() + i) FieldAt<I>(std::move(pOld[i]));
+                        pOld[i].~FieldAt<I>();
+                    }
+                });
+
+            mpMemoryResource->deallocate(pOldMemory, allocationSize(oldCapacity), kAlignment);
+        }
+
+        /** 
+         * @brief  returns the number of elements
+         *  
+         * @return size
+         */
+        std::size_t size() const
+        {
+            return mSize;
+        }
+
+        /** 
+         * @brief  returns whether there is no element
+         *  
+         */
+        bool empty() const
+        {
+            return mSize == 0;
+        }
+
+        /** 
+         * @brief  operator overload for index access to element
+         *  
+         * @param index index of the element
+         * @return references to the data members of the element
+         */
+        Reference operator[](const std::size_t index)
+        {
+            return [&]<std::size_t... I>(std::index_sequence<I...>) { return Reference(column<I>()[index]...); }(std::make_index_sequence<kFieldNum>());
+        }
+
+        /** 
+         * @brief  operator overload for index access to element (const ver)
+         *  
+         * @param index index of the element
+         * @return const references to the data members of the element
+         */
+        ConstReference operator[](const std::size_t index) const
+        {
+            return [&]<std::size_t... I>(std::index_sequence<I...>) { return ConstReference(column<I>()[index]...); }(std::make_index_sequence<kFieldNum>());
+        }
+
+        /** 
+         * @brief  references to the data members of the last element
+         *  
+         */
+        Reference back()
+        {
+            return (*this)[mSize - 1];
+        }
+
+        /** 
+         * @brief  spans over each data member array (aligned to kAlignment)
+         *  
+         * @param offset index of the first element
+         * @param count number of elements
+         * @return tuple of spans
+         */
+        Spans fields(const std::size_t offset, const std::size_t count)
+        {
+            assert(offset + count <= mSize || !"out of range!");
+            return [&]<std::size_t... I>(std::index_sequence<I...>) { return Spans(std::span(column<I>() + offset, count)...); }(std::make_index_sequence<kFieldNum>());
+        }
+
+        /** 
+         * @brief  spans over each data member array (const ver)
+         *  
+         * @param offset index of the first element
+         * @param count number of elements
+         * @return tuple of const spans
+         */
+        ConstSpans fields(const std::size_t offset, const std::size_t count) const
+        {
+            assert(offset + count <= mSize || !"out of range!");
+            return [&]<std::size_t... I>(std::index_sequence<I...>) { return ConstSpans(std::span(column<I>() + offset, count)...); }(std::make_index_sequence<kFieldNum>());
+        }
+
+    private:
+        /** 
+         * @brief  invoke func<I>() for each data member index I
+         *  
+         * @param func template lambda taking the index of the data member as a template argument
+         */
+        template <typename Func>
+        static void forEachField(Func&& func)
+        {
+            [&]<std::size_t... I>(std::index_sequence<I...>) { (func.template operator()<I>(), ...); }(std::make_index_sequence<kFieldNum>());
+        }
+
+        /** 
+         * @brief  byte size of the array of the I-th data member (rounded up to kAlignment)
+         *  
+         */
+        template <std::size_t I>
+        constexpr static std::size_t columnSize(const std::size_t capacity)
+        {
+            return (sizeof(FieldAt<I>) * capacity + kAlignment - 1) / kAlignment * kAlignment;
+        }
+
+        /** 
+         * @brief  byte offset of the array of the I-th data member from the head of the allocation
+         *  
+         */
+        template <std::size_t I>
+        constexpr static std::size_t columnOffset(const std::size_t capacity)
+        {
+            return [&]<std::size_t... J>(std::index_sequence<J...>) { return (std::size_t(0) + ... + columnSize<J>(capacity)); }(std::make_index_sequence<I>());
+        }
+
+        /** 
+         * @brief  byte size of the whole allocation
+         *  
+         */
+        constexpr static std::size_t allocationSize(const std::size_t capacity)
+        {
+            return columnOffset<kFieldNum>(capacity);
+        }
+
+        /** 
+         * @brief  head of the array of the I-th data member
+         *  
+         */
+        template <std::size_t I>
+        FieldAt<I>* column() const
+        {
+            return reinterpret_cast<FieldAt<I>*>(mpMemory + columnOffset<I>(mCapacity));
+        }
+
+        //! memory resource from which the arrays are allocated
+        std::pmr::memory_resource* mpMemoryResource;
+        //! one allocation holding every data member array
+        std::byte* mpMemory;
+        //! number of constructed elements
+        std::size_t mSize;
+        //! number of elements that can be stored without reallocation
+        std::size_t mCapacity;
+    };
+}  // namespace ec2s
+
+#endif
@@ -9,10 +9,22 @@
 #define EC2S_SPARSESET_HPP_
 
 #include "ISparseSet.hpp"
+#include "AlignedAllocator.hpp"
+#include "EmptyStorage.hpp"
+#include "JobSystem.hpp"
+#include "PagedStorage.hpp"
+#include "SoAStorage.hpp"
 #include "Traits.hpp"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <numeric>
 #include <optional>
+#include <span>
+#include <utility>
 
 namespace ec2s
 {
@@ -25,13 +37,252 @@ namespace ec2s
     class SparseSet : public ISparseSet
     {
     public:
+        //! alignment of the head of the packed elements (and of each page of paged storage), matching SoAStorage
+        constexpr static std::size_t kPackedAlignment = 64;
+        //! container of the actual elements, empty types are not stored at all and the others are selected by Traits::ComponentTraits<T>
+        using Storage = std::conditional_t<Traits::IsTag<T>, EmptyStorage<T>,
+                                           std::conditional_t<Traits::IsSoA<T>, SoAStorage<T, typename Traits::ComponentTraits<T>::Layout>,
+                                                              std::conditional_t<Traits::ComponentTraits<T>::kPageSize == 0, AlignedVector<T, kPackedAlignment>, PagedStorage<T, Traits::ComponentTraits<T>::kPageSize>>>>;
+        //! type to access an element (T&, or tuple of references to the data members for SoA components)
+        using Reference = Traits::ReferenceOf<T>;
+        //! type to read an element (const T&, or tuple of const references to the data members for SoA components)
+        using ConstReference = Traits::ConstReferenceOf<T>;
+        //! contiguous run of elements passed to eachChunk() (std::span<T>, or tuple of spans over each data member for SoA components)
+        using Chunk = Traits::ChunkOf<T>;
+        //! contiguous run of elements read through a const SparseSet (std::span<const T>, or tuple of spans over each const data member for SoA components)
+        using ConstChunk = Traits::ConstChunkOf<T>;
+        //! default number of elements passed to eachChunk() at once
+        constexpr static std::size_t kDefaultChunkSize = 256;
+        //! whether removal leaves a tombstone instead of swap-remove
+        constexpr static bool kInPlaceDelete = Traits::ComponentTraits<T>::kInPlaceDelete;
+        //! whether the tick at which each element was added and last changed is kept (every access handing out a mutable element stamps the changed tick, const access never does)
+        constexpr static bool kChangeTicks = Traits::ComponentTraits<T>::kChangeTicks;
+        //! whether each element is stored as a whole T (raw access through ISparseSet::getRaw() is available)
+        constexpr static bool kRawAccessible = !Traits::IsTag<T> && !Traits::IsSoA<T>;
+
+        /**
+         * @brief  random access iterator over the elements in dense order (usable with range-for, std::ranges and the standard parallel algorithms)
+         * @details with in-place deletion, tombstones are skipped, so it is only bidirectional and removing elements while iterating keeps it valid \
+         *          dereferencing the mutable one (Iterator) hands out a mutable element and stamps its changed tick if kChangeTicks, \
+         *          the const one (ConstIterator, from cbegin() or a const SparseSet) never stamps, so read-only loops and algorithms leave the ticks alone
+         * 
+         * @tparam kConst whether the elements are only read
+         */
+        template<bool kConst>
+        class BasicIterator
+        {
+        public:
+            using reference         = std::conditional_t<kConst, ConstReference, Reference>;
+            using iterator_concept  = std::conditional_t<kInPlaceDelete, std::bidirectional_iterator_tag, std::random_access_iterator_tag>;
+            //! SoA components are accessed through a proxy (tuple of references), which only satisfies the legacy input iterator requirements
+            using iterator_category = std::conditional_t<std::is_reference_v<reference>, iterator_concept, std::input_iterator_tag>;
+            using value_type        = std::conditional_t<std::is_reference_v<reference>, T, reference>;
+            using difference_type   = std::ptrdiff_t;
+            //! SparseSet being iterated (const for ConstIterator)
+            using SparseSetPointer  = std::conditional_t<kConst, const SparseSet*, SparseSet*>;
+
+            /** 
+             * @brief  default constructor (singular iterator)
+             *  
+             */
+            BasicIterator()
+                : mpSparseSet(nullptr)
+                , mIndex(0)
+            {
+            }
+
+            /** 
+             * @brief  constructor
+             *  
+             * @param pSparseSet SparseSet to be iterated
+             * @param index dense index
+             */
+            BasicIterator(const SparseSetPointer pSparseSet, const difference_type index)
+                : mpSparseSet(pSparseSet)
+                , mIndex(index)
+            {
+                skipTombstones<1>();
+            }
+
+            /** 
+             * @brief  conversion from the mutable iterator to the const one
+             *  
+             * @param other mutable iterator
+             */
+            template<bool kOtherConst>
+            BasicIterator(const BasicIterator<kOtherConst>& other)
+                requires(kConst && !kOtherConst)
+                : mpSparseSet(other.mpSparseSet)
+                , mIndex(other.mIndex)
+            {
+            }
+
+            reference operator*() const
+            {
+                if constexpr (!kConst)
+                {
+                    mpSparseSet->stamp(static_cast<std::size_t>(mIndex));
+                }
+
+                return mpSparseSet->mPacked[static_cast<std::size_t>(mIndex)];
+            }
+
+            reference operator[](const difference_type n) const
+                requires(!kInPlaceDelete)
+            {
+                return *(*this + n);
+            }
+
+            /** 
+             * @brief  Entity owning the element currently pointed to
+             *  
+             * @return Entity
+             */
+            Entity entity() const
+            {
+                return mpSparseSet->mDenseEntities[static_cast<std::size_t>(mIndex)];
+            }
+
+            BasicIterator& operator++()
+            {
+                ++mIndex;
+                skipTombstones<1>();
+                return *this;
+            }
+
+            BasicIterator operator++(int)
+            {
+                BasicIterator rtn = *this;
+                ++*this;
+                return rtn;
+            }
+
+            BasicIterator& operator--()
+            {
+                --mIndex;
+                skipTombstones<-1>();
+                return *this;
+            }
+
+            BasicIterator operator--(int)
+            {
+                BasicIterator rtn = *this;
+                --*this;
+                return rtn;
+            }
+
+            BasicIterator& operator+=(const difference_type n)
+                requires(!kInPlaceDelete)
+            {
+                mIndex += n;
+                return *this;
+            }
+
+            BasicIterator& operator-=(const difference_type n)
+                requires(!kInPlaceDelete)
+            {
+                mIndex -= n;
+                return *this;
+            }
+
+            friend BasicIterator operator+(BasicIterator itr, const difference_type n)
+                requires(!kInPlaceDelete)
+            {
+                return itr += n;
+            }
+
+            friend BasicIterator operator+(const difference_type n, BasicIterator itr)
+                requires(!kInPlaceDelete)
+            {
+                return itr += n;
+            }
+
+            friend BasicIterator operator-(BasicIterator itr, const difference_type n)
+                requires(!kInPlaceDelete)
+            {
+                return itr -= n;
+            }
+
+            friend difference_type operator-(const BasicIterator& lhs, const BasicIterator& rhs)
+                requires(!kInPlaceDelete)
+            {
+                return lhs.mIndex - rhs.mIndex;
+            }
+
+            friend bool operator==(const BasicIterator& lhs, const BasicIterator& rhs)
+            {
+                return lhs.mIndex == rhs.mIndex;
+            }
+
+            friend auto operator<=>(const BasicIterator& lhs, const BasicIterator& rhs)
+            {
+                return lhs.mIndex <=> rhs.mIndex;
+            }
+
+        private:
+            template<bool>
+            friend class BasicIterator;
+
+            /** 
+             * @brief  move past the tombstones left by in-place deletion in the specified direction (stops at both ends of DenseEntities)
+             *  
+             * @tparam kDirection 1 for forward, -1 for backward
+             */
+            template<difference_type kDirection>
+            void skipTombstones()
+            {
+                if constexpr (kInPlaceDelete)
+                {
+                    const auto& entities   = mpSparseSet->mDenseEntities;
+                    const auto isTombstone = [&entities](const difference_type index) { return entities[static_cast<std::size_t>(index)] == kTombstoneEntity; };
+
+                    if constexpr (kDirection > 0)
+                    {
+                        while (mIndex < static_cast<difference_type>(entities.size()) && isTombstone(mIndex))
+                        {
+                            ++mIndex;
+                        }
+                    }
+                    else
+                    {
+                        while (mIndex > 0 && isTombstone(mIndex))
+                        {
+                            --mIndex;
+                        }
+                    }
+                }
+            }
+
+            //! SparseSet being iterated
+            SparseSetPointer mpSparseSet;
+            //! current dense index
+            difference_type mIndex;
+        };
+
+        //! iterator handing out mutable elements (stamps the changed tick on dereference if kChangeTicks)
+        using Iterator = BasicIterator<false>;
+        //! iterator handing out const elements (never stamps)
+        using ConstIterator = BasicIterator<true>;
 
         /** 
          * @brief  constructor
          *  
+         * @param pMemoryResource memory resource from which all arrays are allocated
          */
-        SparseSet()
-        {}
+        explicit SparseSet(std::pmr::memory_resource* const pMemoryResource = std::pmr::get_default_resource())
+            : ISparseSet(pMemoryResource)
+            , mPacked(pMemoryResource)
+        {
+            mInPlaceDelete   = kInPlaceDelete;
+            mStride          = kRawAccessible ? sizeof(T) : 0;
+            mTrackMembership = Traits::ComponentTraits<T>::kMembershipBitset;
+        }
+
+        /** 
+         * @brief  move constructor (used when the SparseSet is relocated inside StackAny)
+         *  
+         */
+        SparseSet(SparseSet&&) = default;
 
         /** 
          * @brief  destructor
@@ -41,25 +292,91 @@ namespace ec2s
         {}
 
         /** 
-         * @brief  adds an element to the specified Entity
+         * @brief  adds an element to the specified Entity (replaces the element if the Entity already has one)
          *  
          * @tparam Args types of arguments forwarded to the Component constructor
          * @param entity entity to be added an element
          * @param ...args arguments forwarded to the Component constructor
          */
         template<typename... Args>
-        void emplace(Entity entity, Args... args)
+        void emplace(Entity entity, Args&&... args)
         {
             auto index = static_cast<std::size_t>(entity & kEntityIndexMask);
 
-            if (index >= mSparseIndices.size())
+            if (contains(entity))
+            {
+                // replace the existing element
+                if constexpr (Traits::IsSoA<T>)
+                {
+                    mPacked.assign(getSparseIndex(index), T(std::forward<Args>(args)...));
+                }
+                else if constexpr (!Traits::IsTag<T>)
+                {
+                    mPacked[getSparseIndex(index)] = T(std::forward<Args>(args)...);
+                }
+                else if constexpr (sizeof...(Args) > 0)
+                {
+                    // the selected constructor still runs, only the (stateless) result is not stored
+                    static_cast<void>(T(std::forward<Args>(args)...));
+                }
+
+                stamp(getSparseIndex(index));
+
+                mOnUpdate.publish(entity);
+                return;
+            }
+
+            if constexpr (kInPlaceDelete)
             {
-                resizeSparseIndex(index + 1);
+                compactIfSparse();
             }
 
-            mSparseIndices[index] = mPacked.size();
+            assureSparseIndex(index) = mPacked.size();
+            setMembership(index);
             mDenseEntities.emplace_back(entity);
-            mPacked.emplace_back(args...);
+            mPacked.emplace_back(std::forward<Args>(args)...);
+
+            if constexpr (kChangeTicks)
+            {
+                mAddedTicks.emplace_back(mCurrentTick);
+                mChangedTicks.emplace_back(mCurrentTick);
+            }
+
+            if (mpOwningGroup)
+            {
+                mpOwningGroup->onConstruct(entity);
+            }
+
+            mOnConstruct.publish(entity);
+        }
+
+        /** 
+         * @brief  adds a copy of the value to every Entity in [first, last) (appended in one pass for forward iterators, see insertRange())
+         *  
+         * @tparam EntityItr iterator type of Entities
+         * @param first first Entity
+         * @param last end of Entities
+         * @param value value to be copied to each element
+         */
+        template<typename EntityItr>
+        void insert(EntityItr first, EntityItr last, const T& value)
+        {
+            insertRange(first, last, [&value]() -> const T& { return value; });
+        }
+
+        /** 
+         * @brief  adds the values of [valueFirst, valueFirst + (last - first)) to the corresponding Entities in [first, last) (appended in one pass for forward iterators, see insertRange())
+         *  
+         * @tparam EntityItr iterator type of Entities
+         * @tparam ValueItr iterator type of values
+         * @param first first Entity
+         * @param last end of Entities
+         * @param valueFirst first value
+         */
+        template<typename EntityItr, typename ValueItr, typename std::enable_if_t<std::input_iterator<ValueItr>>* = nullptr>
+        void insert(EntityItr first, EntityItr last, ValueItr valueFirst)
+        {
+            insertRange(first, last, [&valueFirst]() -> decltype(auto) { return *valueFirst++; });
         }
 
         /** 
@@ -69,28 +386,109 @@ namespace ec2s
          */
         void reserve(const std::size_t reserveSize)
         {
-            mSparseIndices.reserve(reserveSize);
+            mSparsePages.reserve((reserveSize + kSparsePageSize - 1) / kSparsePageSize);
             mPacked.reserve(reserveSize);
             mDenseEntities.reserve(reserveSize);
+
+            if constexpr (kChangeTicks)
+            {
+                mAddedTicks.reserve(reserveSize);
+                mChangedTicks.reserve(reserveSize);
+            }
         }
 
         /** 
          * @brief  operator overload for index access to element
+         * @details this is mutable access, so the changed tick is stamped if kChangeTicks
          *  
          * @param entity entity as index
          * @return reference to the element
          */
-        T& operator[](const Entity entity)
+        Reference operator[](const Entity entity)
         {
-            auto index = static_cast<size_t>(entity & kEntityIndexMask);
-            assert(index < mSparseIndices.size() || !"accessed by invalid entity!");
-            auto sparseIndex = mSparseIndices[index];
+            const std::size_t sparseIndex = getValidSparseIndex(entity);
+            stamp(sparseIndex);
 
-            assert(sparseIndex < mPacked.size() || !"accessed by invalid(index over) entity!");
+            return mPacked[sparseIndex];
+        }
 
-            assert((entity & kEntitySlotMask) == (mDenseEntities[sparseIndex] & kEntitySlotMask) || !"accessed by invalid(deleted) entity!");
+        /** 
+         * @brief  operator overload for index access to element (const ver, never stamps the changed tick)
+         *  
+         * @param entity entity as index
+         * @return const reference to the element
+         */
+        ConstReference operator[](const Entity entity) const
+        {
+            return mPacked[getValidSparseIndex(entity)];
+        }
 
-            return mPacked[sparseIndex];
+        /** 
+         * @brief  get the tick at which the element of the specified Entity was added
+         *  
+         * @param entity entity having the element
+         * @return added tick
+         */
+        Tick getAddedTick(const Entity entity) const
+        {
+            static_assert(kChangeTicks, "ticks are not kept for this Component type (Traits::ComponentTraits::kChangeTicks)!");
+            assert(contains(entity) || !"accessed by invalid entity!");
+
+            return mAddedTicks[getSparseIndex(static_cast<std::size_t>(entity & kEntityIndexMask))];
+        }
+
+        /** 
+         * @brief  get the tick at which the element of the specified Entity was last added or changed
+         *  
+         * @param entity entity having the element
+         * @return changed tick
+         */
+        Tick getChangedTick(const Entity entity) const
+        {
+            static_assert(kChangeTicks, "ticks are not kept for this Component type (Traits::ComponentTraits::kChangeTicks)!");
+            assert(contains(entity) || !"accessed by invalid entity!");
+
+            return mChangedTicks[getSparseIndex(static_cast<std::size_t>(entity & kEntityIndexMask))];
+        }
+
+        /** 
+         * @brief  get the added tick of the element by its sparse index (for View)
+         *  
+         * @param sparseIndex index of the element
+         * @return added tick
+         */
+        Tick getAddedTickBySparseIndex(const std::size_t sparseIndex) const
+        {
+            return mAddedTicks[sparseIndex];
+        }
+
+        /** 
+         * @brief  get the changed tick of the element by its sparse index (for View)
+         *  
+         * @param sparseIndex index of the element
+         * @return changed tick
+         */
+        Tick getChangedTickBySparseIndex(const std::size_t sparseIndex) const
+        {
+            return mChangedTicks[sparseIndex];
+        }
+
+        /** 
+         * @brief  modifies the element of the specified Entity in place and publishes onUpdate()
+         *  
+         * @tparam Func function type, takes Reference
+         * @param entity entity whose element is modified
+         * @param func function modifying the element
+         * @return reference to the element
+         */
+        template<typename Func>
+        Reference patch(const Entity entity, Func func)
+        {
+            Reference element = (*this)[entity];
+            func(element);
+            mOnUpdate.publish(entity);
+
+            return element;
         }
 
         /** 
@@ -103,8 +501,8 @@ namespace ec2s
         bool getSparseIndexIfValid(const Entity entity, std::size_t& sparseIndex_out)
         {
             auto index = static_cast<size_t>(entity & kEntityIndexMask);
-            std::size_t sparseIndex = 0;
-            if (index >= mSparseIndices.size() || (sparseIndex = mSparseIndices[index]) >= mPacked.size())
+            const std::size_t sparseIndex = getSparseIndex(index);
+            if (sparseIndex >= mPacked.size())
             {
                 sparseIndex_out = 0;
                 return false;
@@ -115,13 +513,28 @@ namespace ec2s
         }
 
         /** 
-         * @brief  find the corresponding element from the sparseIndex
+         * @brief  find the corresponding element from the sparseIndex (mutable access, stamps the changed tick if kChangeTicks)
          *  
          * @param sparseIndex 
          * @param entity used only in DEBUG mode
          * @return 
          */
-        T& getBySparseIndex(std::size_t sparseIndex, [[maybe_unused]] const Entity entity)
+        Reference getBySparseIndex(std::size_t sparseIndex, [[maybe_unused]] const Entity entity)
+        {
+            assert((entity & kEntitySlotMask) == (mDenseEntities[sparseIndex] & kEntitySlotMask) || !"accessed by invalid(deleted) entity!");
+
+            stamp(sparseIndex);
+            return mPacked[sparseIndex];
+        }
+
+        /** 
+         * @brief  find the corresponding element from the sparseIndex (const ver, never stamps the changed tick)
+         *  
+         * @param sparseIndex 
+         * @param entity used only in DEBUG mode
+         * @return 
+         */
+        ConstReference getBySparseIndex(std::size_t sparseIndex, [[maybe_unused]] const Entity entity) const
         {
             assert((entity & kEntitySlotMask) == (mDenseEntities[sparseIndex] & kEntitySlotMask) || !"accessed by invalid(deleted) entity!");
 
@@ -139,10 +552,21 @@ namespace ec2s
         template<typename Func, typename Traits::IsEligibleEachFunc<Func, T>* = nullptr >
         void each(Func func)
         {
-            for (auto& e : mPacked)
-            {
-                func(e);
-            }
+            const IterationScope scope(*this);
+            eachInRange<false>(*this, func, 0, mPacked.size());
+        }
+
+        /** 
+         * @brief  execute the specified function on all elements read only (const ver, never stamps the changed ticks)
+         *  
+         * @tparam Func function type, takes ConstReference
+         * @param func system function
+         */
+        template<typename Func, typename Traits::IsEligibleEachFunc<Func, const T>* = nullptr >
+        void each(Func func) const
+        {
+            const IterationScope scope(*this);
+            eachInRange<false>(*this, func, 0, mPacked.size());
         }
 
         /** 
@@ -155,10 +579,302 @@ namespace ec2s
         template<typename Func, typename Traits::IsEligibleEachFunc<Func, Entity, T>* = nullptr >
         void each(Func func)
         {
-            for (std::size_t i = 0; i < mPacked.size(); ++i)
+            const IterationScope scope(*this);
+            eachInRange<true>(*this, func, 0, mPacked.size());
+        }
+
+        /** 
+         * @brief  system that takes Entity as its first argument, read only (const ver, never stamps the changed ticks)
+         *  
+         * @tparam Func function type, takes Entity and ConstReference
+         * @param func system function
+         */
+        template<typename Func, typename Traits::IsEligibleEachFunc<Func, Entity, const T>* = nullptr >
+        void each(Func func) const
+        {
+            const IterationScope scope(*this);
+            eachInRange<true>(*this, func, 0, mPacked.size());
+        }
+
+        /** 
+         * @brief  iterator to the first element (tombstones of in-place deletion are skipped, nothing is compacted)
+         *  
+         * @return iterator to the first element
+         */
+        Iterator begin()
+        {
+            return Iterator(this, 0);
+        }
+
+        /** 
+         * @brief  iterator past the last element
+         *  
+         * @return iterator past the last element
+         */
+        Iterator end()
+        {
+            return Iterator(this, static_cast<typename Iterator::difference_type>(mPacked.size()));
+        }
+
+        /** 
+         * @brief  const iterator to the first element (never stamps the changed ticks)
+         *  
+         * @return const iterator to the first element
+         */
+        ConstIterator begin() const
+        {
+            return ConstIterator(this, 0);
+        }
+
+        /** 
+         * @brief  const iterator past the last element
+         *  
+         * @return const iterator past the last element
+         */
+        ConstIterator end() const
+        {
+            return ConstIterator(this, static_cast<typename ConstIterator::difference_type>(mPacked.size()));
+        }
+
+        /** 
+         * @brief  const iterator to the first element, also for a mutable SparseSet (never stamps the changed ticks)
+         *  
+         * @return const iterator to the first element
+         */
+        ConstIterator cbegin() const
+        {
+            return begin();
+        }
+
+        /** 
+         * @brief  const iterator past the last element, also for a mutable SparseSet
+         *  
+         * @return const iterator past the last element
+         */
+        ConstIterator cend() const
+        {
+            return end();
+        }
+
+        /** 
+         * @brief  execute the specified function on all elements, split into ranges of grainSize executed on the JobSystem (blocks until all finish)
+         * @details func is invoked concurrently from multiple threads, and the SparseSet must not be modified meanwhile
+         *  
+         * @tparam Func function type, takes the element (optionally preceded by Entity)
+         * @param jobSystem JobSystem whose worker threads execute the ranges
+         * @param func system function
+         * @param grainSize maximum number of elements per job
+         */
+        template<typename Func>
+        void parallelEach(JobSystem& jobSystem, Func func, const std::size_t grainSize = JobSystem::kDefaultGrainSize)
+        {
+            static_assert(std::is_invocable_v<Func, Reference> || std::is_invocable_v<Func, Entity, Reference>, "ineligible Func type!");
+
+            const IterationScope scope(*this);
+            jobSystem.parallelFor(mPacked.size(), grainSize,
+                [&](const std::size_t begin, const std::size_t end)
+                {
+                    eachInRange<!std::is_invocable_v<Func, Reference>>(*this, func, begin, end);
+                });
+        }
+
+        /** 
+         * @brief  number of elements laid out contiguously from the specified dense index (limited by the page boundary of paged storage)
+         *  
+         * @param offset dense index of the first element
+         * @return number of contiguous elements
+         */
+        std::size_t getContiguousLength(const std::size_t offset) const
+        {
+            assert(offset <= mPacked.size() || !"out of range!");
+
+            if constexpr (!Traits::IsTag<T> && !Traits::IsSoA<T> && Traits::ComponentTraits<T>::kPageSize != 0)
+            {
+                constexpr std::size_t kPageSize = Traits::ComponentTraits<T>::kPageSize;
+                return std::min(mPacked.size() - offset, kPageSize - (offset & (kPageSize - 1)));
+            }
+            else
+            {
+                return mPacked.size() - offset;
+            }
+        }
+
+        /** 
+         * @brief  get the contiguous run of elements without copying (mutable access, stamps the changed ticks of the run if kChangeTicks)
+         *  
+         * @param offset dense index of the first element
+         * @param count number of elements (must not exceed getContiguousLength(offset))
+         * @return span (or tuple of spans over each data member for SoA components) of the elements
+         */
+        Chunk getChunk(const std::size_t offset, const std::size_t count)
+        {
+            static_assert(!Traits::IsTag<T>, "empty component types have no data to be chunked!");
+            assert(count <= getContiguousLength(offset) || !"chunk is not contiguous!");
+
+            stampRange(offset, count);
+
+            if constexpr (Traits::IsSoA<T>)
+            {
+                return mPacked.fields(offset, count);
+            }
+            else
+            {
+                return count == 0 ? Chunk() : Chunk(&mPacked[offset], count);
+            }
+        }
+
+        /** 
+         * @brief  get the contiguous run of elements without copying (const ver, never stamps the changed ticks)
+         *  
+         * @param offset dense index of the first element
+         * @param count number of elements (must not exceed getContiguousLength(offset))
+         * @return const span (or tuple of const spans over each data member for SoA components) of the elements
+         */
+        ConstChunk getChunk(const std::size_t offset, const std::size_t count) const
+        {
+            static_assert(!Traits::IsTag<T>, "empty component types have no data to be chunked!");
+            assert(count <= getContiguousLength(offset) || !"chunk is not contiguous!");
+
+            if constexpr (Traits::IsSoA<T>)
+            {
+                return mPacked.fields(offset, count);
+            }
+            else
+            {
+                return count == 0 ? ConstChunk() : ConstChunk(&mPacked[offset], count);
+            }
+        }
+
+        /** 
+         * @brief  execute the specified function on contiguous runs of elements (for explicit SIMD kernels)
+         * @details runs never cross a multiple of chunkSize (nor a page boundary), so runs start at dense indices that are multiples of chunkSize \
+         *          (except right after tombstones of in-place deletion, which are skipped) \
+         *          the packed array (each page, each data member array of SoA) begins at a kPackedAlignment boundary, \
+         *          so such runs also begin at a kPackedAlignment byte boundary if chunkSize * sizeof(element) is a multiple of kPackedAlignment (e.g. the default chunkSize)
+         *  
+         * @tparam Func function type, takes Chunk (std::span<T>, or the spans of each data member for SoA components), optionally preceded by std::span<const Entity>
+         * @param func system function
+         * @param chunkSize maximum number of elements per call
+         */
+        template<typename Func>
+        void eachChunk(Func func, const std::size_t chunkSize = kDefaultChunkSize)
+        {
+            eachChunkOf(*this, func, chunkSize);
+        }
+
+        /** 
+         * @brief  execute the specified function on contiguous runs of elements read only (const ver of eachChunk(), never stamps the changed ticks)
+         *  
+         * @tparam Func function type, takes ConstChunk (std::span<const T>, or the const spans of each data member for SoA components), optionally preceded by std::span<const Entity>
+         * @param func system function
+         * @param chunkSize maximum number of elements per call
+         */
+        template<typename Func>
+        void eachChunk(Func func, const std::size_t chunkSize = kDefaultChunkSize) const
+        {
+            eachChunkOf(*this, func, chunkSize);
+        }
+
+        /** 
+         * @brief  invoke func with the chunk (SoA chunks are expanded to the spans of each data member)
+         *  
+         * @param func function object
+         * @param entities entities of the chunk
+         * @param chunk chunk of the elements
+         */
+        template<typename Func, typename ChunkType>
+        static void invokeWithChunk(Func& func, const std::span<const Entity> entities, const ChunkType& chunk)
+        {
+            if constexpr (Traits::IsSoA<T>)
+            {
+                std::apply(
+                    [&](auto... fields)
+                    {
+                        if constexpr (std::is_invocable_v<Func, std::span<const Entity>, decltype(fields)...>)
+                        {
+                            func(entities, fields...);
+                        }
+                        else
+                        {
+                            func(fields...);
+                        }
+                    },
+                    chunk);
+            }
+            else if constexpr (std::is_invocable_v<Func, std::span<const Entity>, ChunkType>)
+            {
+                func(entities, chunk);
+            }
+            else
+            {
+                func(chunk);
+            }
+        }
+
+        /** 
+         * @brief  execute the specified function once with spans over each data member array (only for SoA components)
+         * @details each span is aligned and contiguous, so that loops over them can be auto-vectorized
+         *  
+         * @tparam Func function type, takes std::span of each data member listed in the SoALayout (optionally preceded by std::span<const Entity>)
+         * @param func system function
+         */
+        template<typename Func>
+        void eachFields(Func func)
+        {
+            static_assert(Traits::IsSoA<T>, "eachFields() is only for the component types stored as SoA!");
+
+            // spans must not contain tombstones
+            compact();
+            stampRange(0, mPacked.size());
+
+            invokeWithChunk(func, std::span<const Entity>(mDenseEntities), mPacked.fields(0, mPacked.size()));
+        }
+
+        /** 
+         * @brief  execute the specified function once with const spans over each data member array (const ver of eachFields(), never stamps the changed ticks)
+         * @details a const SparseSet cannot be compacted, so tombstones of in-place deletion must have been reclaimed by compact() beforehand
+         *  
+         * @tparam Func function type, takes std::span of each const data member listed in the SoALayout (optionally preceded by std::span<const Entity>)
+         * @param func system function
+         */
+        template<typename Func>
+        void eachFields(Func func) const
+        {
+            static_assert(Traits::IsSoA<T>, "eachFields() is only for the component types stored as SoA!");
+            assert(mTombstoneNum == 0 || !"spans must not contain tombstones, compact() first!");
+
+            invokeWithChunk(func, std::span<const Entity>(mDenseEntities), mPacked.fields(0, mPacked.size()));
+        }
+
+        /** 
+         * @brief  sorts elements by the comparator, keeping sparse/dense/packed arrays consistent
+         *  
+         * @tparam Compare comparator type, compares two components (const T&, or Reference for SoA components) or two Entities
+         * @param compare comparator (strict weak ordering)
+         */
+        template<typename Compare>
+        void sort(Compare compare)
+        {
+            compact();
+
+            std::vector<std::size_t> order(mDenseEntities.size());
+            std::iota(order.begin(), order.end(), std::size_t(0));
+
+            if constexpr (Traits::IsSoA<T> && std::is_invocable_r_v<bool, Compare, Reference, Reference>)
+            {
+                std::sort(order.begin(), order.end(), [&](const std::size_t lhs, const std::size_t rhs) { return compare(mPacked[lhs], mPacked[rhs]); });
+            }
+            else if constexpr (!Traits::IsSoA<T> && std::is_invocable_r_v<bool, Compare, const T&, const T&>)
+            {
+                std::sort(order.begin(), order.end(), [&](const std::size_t lhs, const std::size_t rhs) { return compare(std::as_const(mPacked[lhs]), std::as_const(mPacked[rhs])); });
+            }
+            else
             {
-                func(mDenseEntities[i], mPacked[i]);
+                static_assert(std::is_invocable_r_v<bool, Compare, const Entity, const Entity>, "ineligible Compare type!");
+                std::sort(order.begin(), order.end(), [&](const std::size_t lhs, const std::size_t rhs) { return compare(mDenseEntities[lhs], mDenseEntities[rhs]); });
             }
+
+            applyPermutation(order);
         }
 
         /** 
@@ -172,6 +888,235 @@ namespace ec2s
         }
 
     private:
+        /** 
+         * @brief  get the sparse index of the element of the Entity (asserts that the Entity has the element)
+         *  
+         * @param entity entity having the element
+         * @return sparse index
+         */
+        std::size_t getValidSparseIndex(const Entity entity) const
+        {
+            auto index = static_cast<size_t>(entity & kEntityIndexMask);
+            auto sparseIndex = getSparseIndex(index);
+            assert(sparseIndex != kTombstone || !"accessed by invalid entity!");
+
+            assert(sparseIndex < mPacked.size() || !"accessed by invalid(index over) entity!");
+
+            assert((entity & kEntitySlotMask) == (mDenseEntities[sparseIndex] & kEntitySlotMask) || !"accessed by invalid(deleted) entity!");
+
+            return sparseIndex;
+        }
+
+        /** 
+         * @brief  stamp the current tick as the changed tick of the element (if kChangeTicks)
+         *  
+         * @param sparseIndex index of the element handed out mutably
+         */
+        void stamp([[maybe_unused]] const std::size_t sparseIndex)
+        {
+            if constexpr (kChangeTicks)
+            {
+                mChangedTicks[sparseIndex] = mCurrentTick;
+            }
+        }
+
+        /** 
+         * @brief  stamp the current tick as the changed tick of the elements in the dense range [offset, offset + count) (if kChangeTicks)
+         *  
+         * @param offset dense index of the first element
+         * @param count number of elements
+         */
+        void stampRange([[maybe_unused]] const std::size_t offset, [[maybe_unused]] const std::size_t count)
+        {
+            if constexpr (kChangeTicks)
+            {
+                std::fill_n(mChangedTicks.begin() + offset, count, mCurrentTick);
+            }
+        }
+
+        /** 
+         * @brief  implementation of eachChunk() (the chunks are obtained by getChunk(), so the changed ticks are stamped only through a mutable SparseSet)
+         *  
+         * @tparam Self SparseSet, const if the elements are only read
+         * @param self SparseSet whose elements are visited
+         * @param func system function
+         * @param chunkSize maximum number of elements per call
+         */
+        template<typename Self, typename Func>
+        static void eachChunkOf(Self& self, Func& func, const std::size_t chunkSize)
+        {
+            assert(chunkSize > 0 || !"chunkSize must be greater than 0!");
+
+            const IterationScope scope(self);
+            for (std::size_t offset = 0; offset < self.mPacked.size();)
+            {
+                std::size_t count = std::min(chunkSize - offset % chunkSize, self.getContiguousLength(offset));
+
+                if constexpr (kInPlaceDelete)
+                {
+                    const auto& entities = self.mDenseEntities;
+
+                    // chunks never contain tombstones
+                    if (entities[offset] == kTombstoneEntity)
+                    {
+                        ++offset;
+                        continue;
+                    }
+
+                    count = static_cast<std::size_t>(std::find(entities.begin() + offset, entities.begin() + offset + count, kTombstoneEntity) - (entities.begin() + offset));
+                }
+
+                if constexpr (kRawAccessible)
+                {
+                    assert(offset % chunkSize != 0 || chunkSize * sizeof(T) % kPackedAlignment != 0 ||
+                           reinterpret_cast<std::uintptr_t>(std::addressof(self.mPacked[offset])) % kPackedAlignment == 0 || !"chunk is not aligned!");
+                }
+
+                invokeWithChunk(func, std::span<const Entity>(self.mDenseEntities.data() + offset, count), self.getChunk(offset, count));
+                offset += count;
+            }
+        }
+
+        /** 
+         * @brief  execute the specified function on the elements in the dense range [begin, end) (skipping tombstones)
+         * @details the changed ticks are stamped only through a mutable SparseSet
+         *  
+         * @tparam withEntity whether Entity is passed as the first argument
+         * @tparam Self SparseSet, const if the elements are only read
+         * @param self SparseSet whose elements are visited
+         * @param func system function
+         * @param begin first dense index
+         * @param end end of dense indices
+         */
+        template<bool withEntity, typename Self, typename Func>
+        static void eachInRange(Self& self, Func& func, const std::size_t begin, const std::size_t end)
+        {
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                if constexpr (kInPlaceDelete)
+                {
+                    if (self.mDenseEntities[i] == kTombstoneEntity)
+                    {
+                        continue;
+                    }
+                }
+
+                if constexpr (!std::is_const_v<Self>)
+                {
+                    self.stamp(i);
+                }
+
+                if constexpr (withEntity)
+                {
+                    func(self.mDenseEntities[i], self.mPacked[i]);
+                }
+                else
+                {
+                    func(self.mPacked[i]);
+                }
+            }
+        }
+
+        /** 
+         * @brief  implementation of bulk insertion
+         * @details for forward iterators, the sparse page table is sized for the largest Entity index and the other arrays for the count up front, \
+         *          then the new elements are appended in one pass without per-element notification, \
+         *          and the owning Group and onConstruct() listeners are notified afterwards only if there are any \
+         *          (so listeners must not add or remove elements of this SparseSet) \
+         *          Entities which already have an element are replaced as emplace() does, after the constructions appended before them are notified, \
+         *          so notifications are published in the order the Entities are applied
+         *  
+         * @tparam EntityItr iterator type of Entities
+         * @tparam NextValue function type returning the value for the next Entity
+         * @param first first Entity
+         * @param last end of Entities
+         * @param nextValue function returning the value for the next Entity (called once per Entity in order)
+         */
+        template<typename EntityItr, typename NextValue>
+        void insertRange(EntityItr first, EntityItr last, NextValue nextValue)
+        {
+            if constexpr (!std::forward_iterator<EntityItr>)
+            {
+                for (; first != last; ++first)
+                {
+                    emplace(*first, nextValue());
+                }
+            }
+            else
+            {
+                std::size_t count    = 0;
+                std::size_t maxIndex = 0;
+                for (EntityItr itr = first; itr != last; ++itr, ++count)
+                {
+                    maxIndex = std::max(maxIndex, static_cast<std::size_t>(*itr & kEntityIndexMask));
+                }
+
+                if (count == 0)
+                {
+                    return;
+                }
+
+                if constexpr (kInPlaceDelete)
+                {
+                    compactIfSparse();
+                }
+
+                resizeSparseIndex(maxIndex + 1);
+                reserve(mDenseEntities.size() + count);
+
+                // notifies the owning Group and onConstruct() listeners of the elements appended since the last notification
+                // (the Group only swaps each new element with an earlier dense index, so every new Entity is visited once)
+                const bool notifies          = mpOwningGroup || !mOnConstruct.empty();
+                std::size_t notifiedNum      = mDenseEntities.size();
+                const auto notifyConstructed = [this, notifies, &notifiedNum]()
+                {
+                    if (notifies)
+                    {
+                        for (std::size_t i = notifiedNum; i < mDenseEntities.size(); ++i)
+                        {
+                            const Entity entity = mDenseEntities[i];
+                            if (mpOwningGroup)
+                            {
+                                mpOwningGroup->onConstruct(entity);
+                            }
+
+                            mOnConstruct.publish(entity);
+                        }
+                    }
+
+                    notifiedNum = mDenseEntities.size();
+                };
+
+                for (; first != last; ++first)
+                {
+                    const Entity entity      = *first;
+                    const std::size_t index  = static_cast<std::size_t>(entity & kEntityIndexMask);
+                    std::size_t& sparseIndex = assureSparseIndex(index);
+
+                    if (sparseIndex != kTombstone && (mDenseEntities[sparseIndex] & kEntitySlotMask) == (entity & kEntitySlotMask))
+                    {
+                        // the pending constructions precede this replacement, so they are published first to keep the order of application
+                        notifyConstructed();
+                        emplace(entity, nextValue());
+                        continue;
+                    }
+
+                    sparseIndex = mPacked.size();
+                    setMembership(index);
+                    mDenseEntities.emplace_back(entity);
+                    mPacked.emplace_back(nextValue());
+
+                    if constexpr (kChangeTicks)
+                    {
+                        mAddedTicks.emplace_back(mCurrentTick);
+                        mChangedTicks.emplace_back(mCurrentTick);
+                    }
+                }
+
+                notifyConstructed();
+            }
+        }
+
         /** 
          * @brief  implementation of the type-dependent part of element removing
          *  
@@ -179,10 +1124,144 @@ namespace ec2s
          */
         virtual void removePackedElement(std::size_t sparseIndex) override
         {
-            std::swap(mPacked[sparseIndex], mPacked.back());
+            // the last element is moved (not swapped) into the hole, then the moved-from tail is destructed
+            const std::size_t last = mPacked.size() - 1;
+            if (sparseIndex != last)
+            {
+                if constexpr (Traits::IsSoA<T>)
+                {
+                    mPacked.moveElement(sparseIndex, last);
+                }
+                else if constexpr (!Traits::IsTag<T>)
+                {
+                    mPacked[sparseIndex] = std::move(mPacked[last]);
+                }
+
+                if constexpr (kChangeTicks)
+                {
+                    mAddedTicks[sparseIndex]   = mAddedTicks[last];
+                    mChangedTicks[sparseIndex] = mChangedTicks[last];
+                }
+            }
             mPacked.pop_back();
+
+            if constexpr (kChangeTicks)
+            {
+                mAddedTicks.pop_back();
+                mChangedTicks.pop_back();
+            }
         }
         
+        /** 
+         * @brief  implementation of raw element access
+         *  
+         * @param sparseIndex index of the element
+         * @return pointer to the element (nullptr for empty types and structure-of-arrays)
+         */
+        virtual void* getRawPackedElement(std::size_t sparseIndex) override
+        {
+            if constexpr (kRawAccessible)
+            {
+                stamp(sparseIndex);
+                return static_cast<void*>(std::addressof(mPacked[sparseIndex]));
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+
+        /** 
+         * @brief  implementation of raw element access (const ver, never stamps)
+         *  
+         * @param sparseIndex index of the element
+         * @return pointer to the element (nullptr for empty types and structure-of-arrays)
+         */
+        virtual const void* getRawPackedElement(std::size_t sparseIndex) const override
+        {
+            if constexpr (kRawAccessible)
+            {
+                return static_cast<const void*>(std::addressof(mPacked[sparseIndex]));
+            }
+            else
+            {
+                return nullptr;
+            }
+        }
+
+        /** 
+         * @brief  implementation of the type-dependent part of element swapping
+         *  
+         * @param lhs index of the first element
+         * @param rhs index of the second element
+         */
+        virtual void swapPackedElement(std::size_t lhs, std::size_t rhs) override
+        {
+            swapPacked(lhs, rhs);
+        }
+
+        /** 
+         * @brief  implementation of compaction, removes all elements marked by kTombstoneEntity in one linear pass
+         *  
+         */
+        virtual void compactPackedElement() override
+        {
+            std::size_t dst = 0;
+            for (std::size_t src = 0; src < mDenseEntities.size(); ++src)
+            {
+                if (mDenseEntities[src] == kTombstoneEntity)
+                {
+                    continue;
+                }
+
+                if (dst != src)
+                {
+                    mDenseEntities[dst] = mDenseEntities[src];
+                    assureSparseIndex(static_cast<std::size_t>(mDenseEntities[dst] & kEntityIndexMask)) = dst;
+                    // removed elements are carried to the tail and destructed below
+                    swapPacked(dst, src);
+                }
+
+                ++dst;
+            }
+
+            mDenseEntities.resize(dst);
+            while (mPacked.size() > dst)
+            {
+                mPacked.pop_back();
+            }
+
+            if constexpr (kChangeTicks)
+            {
+                mAddedTicks.resize(dst);
+                mChangedTicks.resize(dst);
+            }
+        }
+
+        /** 
+         * @brief  swap two packed elements according to the storage
+         *  
+         * @param lhs index of the first element
+         * @param rhs index of the second element
+         */
+        void swapPacked(const std::size_t lhs, const std::size_t rhs)
+        {
+            if constexpr (Traits::IsSoA<T>)
+            {
+                mPacked.swapElements(lhs, rhs);
+            }
+            else if constexpr (!Traits::IsTag<T>)
+            {
+                std::swap(mPacked[lhs], mPacked[rhs]);
+            }
+
+            if constexpr (kChangeTicks)
+            {
+                std::swap(mAddedTicks[lhs], mAddedTicks[rhs]);
+                std::swap(mChangedTicks[lhs], mChangedTicks[rhs]);
+            }
+        }
+
         /** 
          * @brief  implementation of the type-dependent part of all element clearing
          *  
@@ -190,10 +1269,12 @@ namespace ec2s
         virtual void clearPackedElement() override
         {
             mPacked.clear();
+            mAddedTicks.clear();
+            mChangedTicks.clear();
         }
 
-        //! actual element's vector
-        std::vector<T> mPacked;
+        //! actual elements
+        Storage mPacked;
     };
 }
 
@@ -9,6 +9,10 @@
 #define EC2S_STACKANY_HPP_
 
 #include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 #include <cassert>
 
 #include "TypeHash.hpp"
@@ -17,8 +21,9 @@ namespace ec2s
 {
     /**
      * @brief  Any type built on a fixed amount of memory on the Stack (only for SparseSet)
-     * @details because runtime type information and any_cast are not used, the get() is faster than std::any
-     * 
+     * @details because runtime type information and any_cast are not used, the get() is faster than std::any \
+     *          the stored type is operated through a static table of type-erased operations, so storing and resetting never allocate
+     *
      * @tparam kMemSize size of the instance stored in this StackAny
      */
     template <size_t kMemSize>
@@ -26,161 +31,161 @@ namespace ec2s
     {
     private:
         /**
-         * @brief  interface type to call destructor of stored type
+         * @brief  table of type-erased operations of the stored type
          */
-        class IDestructor
+        struct Operations
         {
-        public:
-            /** 
-             * @brief  destructor (itself)
-             *  
-             */
-            virtual ~IDestructor()
-            {
-            }
-
-            /** 
-             * @brief  call destructors according to the type of the child
-             *  
-             * @param p pointer of the type of the child
-             */
-            virtual void invoke(void* const p) = 0;
+            //! call the destructor of the stored value
+            void (*destroy)(void* const p);
+            //! move-construct the value of pSrc into pDst, then destroy the value of pSrc
+            void (*move)(void* const pDst, void* const pSrc);
+            //! size of the stored type
+            std::size_t size;
         };
 
         /**
-         * @brief  concrete type to call destructor of stored type
-         * 
-         * @tparam T type to be called destructor
+         * @brief  operation table of the type T (one constant per type)
+         *
+         * @tparam T stored type
          */
         template <typename T>
-        class Destructor : public IDestructor
-        {
-        public:
-            /** 
-             * @brief  destructor (itself)
-             *  
-             */
-            virtual ~Destructor()
-            {
-            }
-
-            /** 
-             * @brief  call destructors according to the type T
-             *  
-             * @param p pointer of the type T
-             */
-            virtual void invoke(void* const p) override
+        constexpr static Operations kOperations = {
+            [](void* const p) { std::launder(reinterpret_cast<T*>(p))->~T(); },
+            [](void* const pDst, void* const pSrc)
             {
-                reinterpret_cast<T*>(p)->~T();
-            }
+                T* const pFrom = std::launder(reinterpret_cast<T*>(pSrc));
+                new (pDst) T(std::move(*pFrom));
+                pFrom->~T();
+            },
+            sizeof(T),
         };
 
     public:
-        /** 
+        /**
          * @brief  constructor
-         *  
+         *
          */
         StackAny()
-            : mpDestructor(nullptr)
+            : mpMemory{}
+            , mpOperations(nullptr)
             , mTypeHash(0)
-            , mpMemory{}
         {
         }
 
-        /** 
-         * @brief  constructor from value to be stored (lvalue ver)
-         *  
-         * @param from value to be stored 
+        /**
+         * @brief  constructor that constructs the value to be stored in place (no copy of the value)
+         *
+         * @tparam T type of the value to be stored
+         * @tparam Args types of arguments forwarded to the constructor of T
+         * @param ...args arguments forwarded to the constructor of T
          */
-        template <typename T>
-        StackAny(const T& from)
+        template <typename T, typename... Args>
+        StackAny(std::in_place_type_t<T>, Args&&... args)
         {
             static_assert(sizeof(T) <= kMemSize, "invalid type size!");
-            new (mpMemory) T(from);
-            mpDestructor = new Destructor<T>();
+            static_assert(alignof(T) <= alignof(std::max_align_t), "invalid type alignment!");
+            new (mpMemory) T(std::forward<Args>(args)...);
+            mpOperations = &kOperations<T>;
             mTypeHash    = TypeHasher::hash<T>();
         }
 
-        /** 
-         * @brief  constructor from value to be stored (rvalue ver)
-         *  
-         * @param from value to be stored 
+        /**
+         * @brief  constructor from value to be stored (copies lvalues, moves rvalues)
+         *
+         * @tparam T type of the value to be stored
+         * @param from value to be stored
          */
-        template <typename T>
-        StackAny(const T&& from)
+        template <typename T, typename = std::enable_if_t<!std::is_same_v<std::remove_cvref_t<T>, StackAny>>>
+        StackAny(T&& from)
+            : StackAny(std::in_place_type<std::remove_cvref_t<T>>, std::forward<T>(from))
         {
-            static_assert(sizeof(T) <= kMemSize, "invalid type size!");
-            new (mpMemory) T(from);
-            mpDestructor = new Destructor<T>();
-            mTypeHash    = TypeHasher::hash<T>();
         }
 
-        /** 
-         * @brief  destructor
-         *  
+        /**
+         * @brief  move constructor (the stored value is relocated and other becomes empty)
+         *
+         * @param other StackAny to be moved from
          */
-        ~StackAny()
+        StackAny(StackAny&& other) noexcept
+            : mpOperations(other.mpOperations)
+            , mTypeHash(other.mTypeHash)
         {
-            if (mpDestructor)
+            if (mpOperations)
             {
-                mpDestructor->invoke(mpMemory);
-                delete mpDestructor;
+                mpOperations->move(mpMemory, other.mpMemory);
+                other.mpOperations = nullptr;
+                other.mTypeHash    = 0;
             }
         }
 
-        /** 
-         * @brief  operator overloading for assigning values (lvalue ver)
-         *  
-         * @tparam T value type
-         * @param from value
-         * @return reference of value
+        //! copy is prohibited (the stored value is owned exclusively)
+        StackAny(const StackAny&) = delete;
+
+        /**
+         * @brief  destructor
+         *
          */
-        template <typename T>
-        T& operator=(const T& from)
+        ~StackAny()
         {
-            static_assert(sizeof(T) <= kMemSize, "invalid type size!");
+            reset();
+        }
 
-            if (mpDestructor)
+        //! copy is prohibited (the stored value is owned exclusively)
+        StackAny& operator=(const StackAny&) = delete;
+
+        /**
+         * @brief  move assignment (the stored value is relocated and other becomes empty)
+         *
+         * @param other StackAny to be moved from
+         * @return reference to this
+         */
+        StackAny& operator=(StackAny&& other) noexcept
+        {
+            if (this == &other)
             {
-                mpDestructor->invoke(mpMemory);
-                delete mpDestructor;
+                return *this;
             }
 
-            new (mpMemory) T(from);
-            mpDestructor = new Destructor<T>();
-            mTypeHash    = TypeHasher::hash<T>();
+            reset();
+
+            if (other.mpOperations)
+            {
+                other.mpOperations->move(mpMemory, other.mpMemory);
+                mpOperations       = other.mpOperations;
+                mTypeHash          = other.mTypeHash;
+                other.mpOperations = nullptr;
+                other.mTypeHash    = 0;
+            }
 
-            return *(reinterpret_cast<T*>(mpMemory));
+            return *this;
         }
 
-        /** 
-         * @brief  operator overloading for assigning values (rvalue ver)
-         *  
+        /**
+         * @brief  operator overloading for assigning values (copies lvalues, moves rvalues)
+         *
          * @tparam T value type
          * @param from value
          * @return reference of value
          */
-        template <typename T>
-        T& operator=(const T&& from)
+        template <typename T, typename = std::enable_if_t<!std::is_same_v<std::remove_cvref_t<T>, StackAny>>>
+        std::remove_cvref_t<T>& operator=(T&& from)
         {
-            static_assert(sizeof(T) <= kMemSize, "invalid type size!");
+            using Stored = std::remove_cvref_t<T>;
+            static_assert(sizeof(Stored) <= kMemSize, "invalid type size!");
+            static_assert(alignof(Stored) <= alignof(std::max_align_t), "invalid type alignment!");
 
-            if (mpDestructor)
-            {
-                mpDestructor->invoke(mpMemory);
-                delete mpDestructor;
-            }
+            reset();
 
-            new (mpMemory) T(from);
-            mpDestructor = new Destructor<T>();
-            mTypeHash    = TypeHasher::hash<T>();
+            new (mpMemory) Stored(std::forward<T>(from));
+            mpOperations = &kOperations<Stored>;
+            mTypeHash    = TypeHasher::hash<Stored>();
 
-            return *(reinterpret_cast<T*>(mpMemory));
+            return *std::launder(reinterpret_cast<Stored*>(mpMemory));
         }
 
-        /** 
-         * @brief get (cast) the stored value 
-         *  
+        /**
+         * @brief get (cast) the stored value
+         *
          * @tparam T type to be obtained as
          * @return stored value casted to T
          */
@@ -189,35 +194,45 @@ namespace ec2s
         {
             static_assert(sizeof(T) <= kMemSize, "invalid type size!");
 
-            if (TypeHasher::hash<T>() != mTypeHash)
+            if (!mpOperations || TypeHasher::hash<T>() != mTypeHash)
             {
-                throw std::exception("invalid type cast (StackAny)!");
+                throw std::runtime_error("invalid type cast (StackAny)!");
             }
 
-            return *(reinterpret_cast<T*>(mpMemory));
+            return *std::launder(reinterpret_cast<T*>(mpMemory));
         }
 
-        /** 
+        /**
+         * @brief  checks if a value is stored
+         *
+         * @return whether a value is stored
+         */
+        bool hasValue() const
+        {
+            return mpOperations != nullptr;
+        }
+
+        /**
          * @brief  delete and reset stored values and information
-         *  
+         *
          */
         void reset()
         {
-            if (!mpDestructor)
+            if (!mpOperations)
             {
                 return;
             }
 
-            mpDestructor->invoke(mpMemory);
-            delete mpDestructor;
-            mpDestructor = nullptr;
+            mpOperations->destroy(mpMemory);
+            mpOperations = nullptr;
+            mTypeHash    = 0;
         }
 
     private:
         //! stack memory area to store values
-        std::byte mpMemory[kMemSize];
-        //! pointer to call destructor
-        IDestructor* mpDestructor;
+        alignas(std::max_align_t) std::byte mpMemory[kMemSize];
+        //! table of type-erased operations of the stored type (nullptr if empty)
+        const Operations* mpOperations;
         //! type hash of the stored type
         std::size_t mTypeHash;
     };
@@ -8,21 +8,283 @@
 #ifndef EC2S_TRAITS_HPP_
 #define EC2S_TRAITS_HPP_
 
+#include <cstddef>
+#include <span>
+#include <tuple>
 #include <type_traits>
 
 namespace ec2s
 {
+	/**
+	 * @brief  tag type marking a Component type as optional in a View (e.g. View<Sprite, Optional<Tint>>)
+	 * @details the entities are not required to have it, and a pointer (nullptr if absent) is passed instead of a reference
+	 *
+	 * @tparam T Component type
+	 */
+	template<typename T>
+	struct Optional
+	{
+	};
+
+	/**
+	 * @brief  tag type filtering a View to the entities whose Component was added after the tick given by View::since() (e.g. View<Added<Transform>>)
+	 * @details the argument is the same as for T, and the SparseSet of T must maintain ticks (Traits::ComponentTraits::kChangeTicks)
+	 *
+	 * @tparam T Component type
+	 */
+	template<typename T>
+	struct Added
+	{
+	};
+
+	/**
+	 * @brief  tag type filtering a View to the entities whose Component was added or changed after the tick given by View::since() (e.g. View<Changed<Transform>>)
+	 * @details the argument is the same as for T, and the SparseSet of T must maintain ticks (Traits::ComponentTraits::kChangeTicks)
+	 *
+	 * @tparam T Component type
+	 */
+	template<typename T>
+	struct Changed
+	{
+	};
+
 	//! namespace for all traits
 	namespace Traits
 	{
 		/**
-		 * @brief  whether a Func is a callable function type with Types&... as an arguments
+		 * @brief  list of the data members of a component type stored as structure-of-arrays (every data member must be listed)
+		 * 
+		 * @tparam Members pointers to the data members (e.g. &Position::x, &Position::y)
+		 */
+		template<auto... Members>
+		struct SoALayout
+		{
+		};
+
+		/**
+		 * @brief  default storage settings of component types
+		 */
+		struct DefaultComponentTraits
+		{
+			//! number of components stored in one page, 0 means a single contiguous array (elements may be relocated on growth)
+			static constexpr std::size_t kPageSize = 0;
+			//! SoALayout to store each data member in its own aligned array, void means an array of whole structures
+			using Layout = void;
+			//! whether removal leaves a tombstone instead of swap-remove (iteration stays stable while removing, holes are reclaimed by compaction)
+			static constexpr bool kInPlaceDelete = false;
+			//! whether the SparseSet maintains a hierarchical bitset of its entity indices, so that multi-component Views skip whole blocks without matches (each() then visits in entity index order)
+			static constexpr bool kMembershipBitset = false;
+			//! whether the SparseSet keeps the tick at which each element was added and last changed (every mutable access stamps it, e.g. non-const Registry::get(), patch(), each() and Views without const), for Added<T> and Changed<T>
+			static constexpr bool kChangeTicks = false;
+		};
+
+		/**
+		 * @brief  storage settings of the component type T
+		 * @details specialize this (derived from DefaultComponentTraits) to change the storage of a specific component type
+		 *
+		 * @tparam T component type
+		 */
+		template<typename T>
+		struct ComponentTraits : public DefaultComponentTraits
+		{
+		};
+
+		/**
+		 * @brief  obtain the data member type from a pointer to data member type
+		 * 
+		 * @tparam MemberPointer pointer to data member type
+		 */
+		template<typename MemberPointer>
+		struct MemberPointerTraits;
+
+		template<typename Class, typename Field>
+		struct MemberPointerTraits<Field Class::*>
+		{
+			using FieldType = Field;
+		};
+
+		//! whether the component type T is a tag stored without elements (empty, and both constructed and destructed trivially, so skipping them is unobservable)
+		template<typename T>
+		constexpr bool IsTag = std::is_empty_v<T> && std::is_trivially_default_constructible_v<T> && std::is_trivially_destructible_v<T>;
+
+		//! whether the component type T is stored as structure-of-arrays
+		template<typename T>
+		constexpr bool IsSoA = !std::is_void_v<typename ComponentTraits<std::remove_const_t<T>>::Layout>;
+
+		/**
+		 * @brief  type to access an element of the component type T (T&, or tuple of references to the data members for SoALayout)
+		 * 
+		 * @tparam T component type
+		 */
+		template<typename T, typename Layout = typename ComponentTraits<T>::Layout>
+		struct ComponentReference
+		{
+			using type = T&;
+		};
+
+		template<typename T, auto... Members>
+		struct ComponentReference<T, SoALayout<Members...>>
+		{
+			using type = std::tuple<typename MemberPointerTraits<decltype(Members)>::FieldType&...>;
+		};
+
+		/**
+		 * @brief  type to read an element of the component type T (const T&, or tuple of const references to the data members for SoALayout)
+		 * 
+		 * @tparam T component type
+		 */
+		template<typename T, typename Layout = typename ComponentTraits<T>::Layout>
+		struct ComponentConstReference
+		{
+			using type = const T&;
+		};
+
+		template<typename T, auto... Members>
+		struct ComponentConstReference<T, SoALayout<Members...>>
+		{
+			using type = std::tuple<const typename MemberPointerTraits<decltype(Members)>::FieldType&...>;
+		};
+
+		//! shorthand of ComponentConstReference<T>::type
+		template<typename T>
+		using ConstReferenceOf = typename ComponentConstReference<T>::type;
+
+		//! const Component type in a View is read only (never stamps the changed tick)
+		template<typename T, typename Layout>
+		struct ComponentReference<const T, Layout>
+		{
+			using type = ConstReferenceOf<T>;
+		};
+
+		template<typename T, typename Layout>
+		struct ComponentReference<Optional<T>, Layout>
+		{
+			static_assert(!IsSoA<T>, "a Component type stored as structure-of-arrays cannot be optional!");
+			using type = T*;
+		};
+
+		template<typename T, typename Layout>
+		struct ComponentReference<Added<T>, Layout> : public ComponentReference<T>
+		{
+		};
+
+		template<typename T, typename Layout>
+		struct ComponentReference<Changed<T>, Layout> : public ComponentReference<T>
+		{
+		};
+
+		//! shorthand of ComponentReference<T>::type
+		template<typename T>
+		using ReferenceOf = typename ComponentReference<T>::type;
+
+		/**
+		 * @brief  type of a contiguous run of the component type T (std::span<T>, or tuple of spans over each data member for SoALayout)
+		 * 
+		 * @tparam T component type
+		 */
+		template<typename T, typename Layout = typename ComponentTraits<T>::Layout>
+		struct ComponentChunk
+		{
+			using type = std::span<T>;
+		};
+
+		template<typename T, auto... Members>
+		struct ComponentChunk<T, SoALayout<Members...>>
+		{
+			using type = std::tuple<std::span<typename MemberPointerTraits<decltype(Members)>::FieldType>...>;
+		};
+
+		//! shorthand of ComponentChunk<T>::type
+		template<typename T>
+		using ChunkOf = typename ComponentChunk<T>::type;
+
+		/**
+		 * @brief  type to read a contiguous run of the component type T (std::span<const T>, or tuple of spans over each const data member for SoALayout)
+		 * 
+		 * @tparam T component type
+		 */
+		template<typename T, typename Layout = typename ComponentTraits<T>::Layout>
+		struct ComponentConstChunk
+		{
+			using type = std::span<const T>;
+		};
+
+		template<typename T, auto... Members>
+		struct ComponentConstChunk<T, SoALayout<Members...>>
+		{
+			using type = std::tuple<std::span<const typename MemberPointerTraits<decltype(Members)>::FieldType>...>;
+		};
+
+		//! shorthand of ComponentConstChunk<T>::type
+		template<typename T>
+		using ConstChunkOf = typename ComponentConstChunk<T>::type;
+
+		//! whether the type T is an Optional Component type of a View
+		template<typename T>
+		constexpr bool IsOptional = false;
+
+		template<typename T>
+		constexpr bool IsOptional<Optional<T>> = true;
+
+		//! whether the type T is an Added Component type of a View
+		template<typename T>
+		constexpr bool IsAdded = false;
+
+		template<typename T>
+		constexpr bool IsAdded<Added<T>> = true;
+
+		//! whether the type T is a Changed Component type of a View
+		template<typename T>
+		constexpr bool IsChanged = false;
+
+		template<typename T>
+		constexpr bool IsChanged<Changed<T>> = true;
+
+		/**
+		 * @brief  Component type referred to by the View argument type T (T itself, or the inner type of Optional<T> / Added<T> / Changed<T>)
+		 *
+		 * @tparam T View argument type
+		 */
+		template<typename T>
+		struct ViewComponent
+		{
+			using type = T;
+		};
+
+		template<typename T>
+		struct ViewComponent<Optional<T>>
+		{
+			using type = T;
+		};
+
+		template<typename T>
+		struct ViewComponent<Added<T>>
+		{
+			using type = T;
+		};
+
+		template<typename T>
+		struct ViewComponent<Changed<T>>
+		{
+			using type = T;
+		};
+
+		//! shorthand of ViewComponent<T>::type (without const)
+		template<typename T>
+		using ComponentOf = std::remove_const_t<typename ViewComponent<T>::type>;
+
+		//! whether the View argument type T refers to its Component read only (const T, or const inside Optional / Added / Changed)
+		template<typename T>
+		constexpr bool IsReadOnly = std::is_const_v<typename ViewComponent<T>::type>;
+
+		/**
+		 * @brief  whether a Func is a callable function type with references of Types... as an arguments
 		 * 
 		 * @tparam Func function type
 		 * @tparam Types arguments types
 		 */
 		template<typename Func, typename... Types>
-		using IsEligibleEachFunc = std::enable_if_t<std::is_invocable_v<Func, Types&...>>;
+		using IsEligibleEachFunc = std::enable_if_t<std::is_invocable_v<Func, ReferenceOf<Types>...>>;
 	}
 }
 
@@ -9,16 +9,14 @@
 #define EC2S_TYPEHASH_HPP_
 
 #include <cstdint>
+#include <mutex>
 #include <string_view>
+#include <unordered_map>
 #include <vector>
 #include <utility>
 
 #include <cassert>
 
-#ifdef EC2S_CHECK_SYNONYM
-#include <unordered_map>
-#endif
-
 //! macros to identify execution environment OS
 #if defined _WIN32 || defined __CYGWIN__ || defined _MSC_VER
 #define GENERATOR_EXPORT __declspec(dllexport)
@@ -138,7 +136,46 @@ namespace ec2s
 #endif
 #endif
 
+        /**
+         * @brief  obtain a small sequential index of the specified type (assigned on first use, shared by the whole process)
+         * @detail unlike hash(), the indices are dense, so they can be used to index arrays directly \
+         *         the index is resolved from hash() by the single non-template TypeIndexGenerator, so every module (DLL / shared object) obtains the same index for the same type \
+         *         as long as hash() is computed at compile time (GENERATOR_PRETTY_FUNCTION is available) and TypeIndexGenerator is one instance in the process \
+         *         (the module defining GENERATOR_API_EXPORT exports it and the others define GENERATOR_API_IMPORT, on ELF platforms default visibility suffices) \
+         *         otherwise, the indices are valid only within a single module
+         * 
+         * @tparam Type seeking index
+         */
+        template <typename Type>
+        static std::size_t index()
+        {
+            // the local cache may be duplicated per module, but every copy holds the index resolved from the same hash
+            static const std::size_t value = TypeIndexGenerator::indexOf(hash<Type>());
+            return value;
+        }
+
     private:
+        /**
+         * @brief  assigns sequential indices to type hashes, used by index()
+         */
+        struct GENERATOR_API TypeIndexGenerator
+        {
+            /** 
+             * @brief  return the index of the type hash, assigning the next sequential index on its first query (thread-safe)
+             *  
+             * @param typeHash type hash obtained by hash()
+             * @return unique sequential index of the type hash
+             */
+            static std::size_t indexOf(const TypeHash typeHash)
+            {
+                static std::mutex mutex;
+                static std::unordered_map<TypeHash, std::size_t> indices;
+
+                std::lock_guard<std::mutex> lock(mutex);
+                return indices.try_emplace(typeHash, indices.size()).first->second;
+            }
+        };
+
         /**
          * @brief  type hash computation types in environments where unique function names are not available
          */
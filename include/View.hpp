@@ -8,21 +8,230 @@
 #ifndef EC2S_VIEW_HPP_
 #define EC2S_VIEW_HPP_
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <span>
 #include <tuple>
+#include <utility>
 
 #include "SparseSet.hpp"
 
 namespace ec2s
 {
+    /**
+     * @brief  tag type listing the Component types excluded from a View
+     * @tparam ExcludedTypes Component types which the entities must not have
+     */
+    template<typename... ExcludedTypes>
+    struct Exclude
+    {
+    };
+
+    //! exclusion list passed to Registry::view(), e.g. registry.view<A, B>(exclude<C, D>)
+    template<typename... ExcludedTypes>
+    inline constexpr Exclude<ExcludedTypes...> exclude{};
+
     /**
      * @brief  View class, generated from Registry, providing each for multiple Components
+     * @details a Component type wrapped in Optional<T> does not filter the entities, its argument is T* (nullptr if the entity does not have it) \
+     *          Added<T> / Changed<T> pass T like the plain type, but only for the Components stamped after the tick given by since() \
+     *          Components handed out mutably (by each(), parallelEach() or the iterators) are stamped as changed if they keep ticks, \
+     *          so read-only systems declare them const (e.g. view<const T>, Optional<const T>, Changed<const T>) to be passed const references without stamping \
+     *          if the SparseSets of all the others maintain a membership bitset (Traits::ComponentTraits::kMembershipBitset), each() visits the entities in index order by intersecting the bitsets
      * @tparam ComponentType type of ComponentData this View refers to (at least one)
      * @tparam OtherComponentTypes for multiple Component types
      */
     template<typename ComponentType, typename... OtherComponentTypes>
     class View
     {
+        static_assert(!(Traits::IsOptional<ComponentType> && ... && Traits::IsOptional<OtherComponentTypes>), "at least one Component type of a View must not be optional!");
+
+    private:
+        //! number of Component types (including the optional ones)
+        constexpr static std::size_t kTypeNum = sizeof...(OtherComponentTypes) + 1;
+
+        //! index sequence over all Component types
+        constexpr static auto kIndices = std::index_sequence_for<ComponentType, OtherComponentTypes...>();
+
+        //! I-th Component type of this View
+        template<std::size_t I>
+        using TypeAt = std::tuple_element_t<I, std::tuple<ComponentType, OtherComponentTypes...>>;
+
+        //! SparseSet storing the Component type T (the inner type for Optional<T>)
+        template<typename T>
+        using SparseSetOf = SparseSet<Traits::ComponentOf<T>>;
+
+        //! number of non-optional Component types (which filter the entities)
+        constexpr static std::size_t kRequiredNum = ((Traits::IsOptional<ComponentType> ? 0 : 1) + ... + (Traits::IsOptional<OtherComponentTypes> ? 0 : 1));
+
+        //! whether the Component type T does not prevent intersecting the membership bitsets (optional, or its SparseSet maintains one)
+        template<typename T>
+        constexpr static bool kHasMembership = Traits::IsOptional<T> || Traits::ComponentTraits<Traits::ComponentOf<T>>::kMembershipBitset;
+
+        //! whether each() intersects the membership bitsets of the SparseSets instead of probing every SparseSet for each pivot entity
+        constexpr static bool kUseMembership = (kHasMembership<ComponentType> && ... && kHasMembership<OtherComponentTypes>) && kRequiredNum >= 2;
+
+        /**
+         * @brief  SparseSets of the excluded Component types, resolved once when the View is built
+         * @details held inline (not in a heap array), so that copying the View and its iterators never allocates
+         */
+        struct Exclusion
+        {
+            //! maximum number of excluded Component types (the View type does not carry the excluded types, so the capacity is fixed, Registry::view() rejects more at compile time)
+            constexpr static std::size_t kMaxNum = 8;
+
+            /** 
+             * @brief  checks if the entity has any of the excluded Components
+             *  
+             * @param entity entity to be checked
+             * @return whether the entity is excluded
+             */
+            bool excludes(const Entity entity) const
+            {
+                for (std::size_t i = 0; i < num; ++i)
+                {
+                    if (pSparseSets[i]->contains(entity))
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            //! SparseSets of the excluded Component types
+            std::array<const ISparseSet*, kMaxNum> pSparseSets{};
+            //! number of excluded Component types
+            std::size_t num = 0;
+        };
+
     public:
+        //! maximum number of Component types that can be excluded
+        constexpr static std::size_t kMaxExcludedNum = Exclusion::kMaxNum;
+
+        /**
+         * @brief  multipass forward iterator yielding std::tuple(Entity, references to each Component) for the entities having all of the Components
+         * @details walks the DenseEntities of the smallest SparseSet and lazily skips the entities missing any of the other Components \
+         *          it refers to the SparseSets (not to the View), so it stays valid after the View itself is destroyed \
+         *          reference is a proxy (a prvalue tuple whose members are references to the Components), so writes go through its members, \
+         *          e.g. std::ranges::for_each(view, [](auto tuple) { std::get<1>(tuple).value = 0; }) \
+         *          it is a C++20 forward iterator (multipass), but only a legacy input iterator since the reference is not a real reference, \
+         *          and it cannot be random access (the skipped entities are found only by walking), \
+         *          so the standard parallel algorithms do not split it and run serially, use parallelEach() (which splits the pivot DenseEntities) for parallelism
+         */
+        class Iterator
+        {
+        public:
+            //! multipass (copies advance independently and compare equal at the same entity)
+            using iterator_concept  = std::forward_iterator_tag;
+            //! the legacy forward iterator requirements need reference to be value_type&, which the proxy is not
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = std::tuple<Entity, Traits::ReferenceOf<ComponentType>, Traits::ReferenceOf<OtherComponentTypes>...>;
+            using difference_type   = std::ptrdiff_t;
+            using reference         = value_type;
+
+            /** 
+             * @brief  default constructor (singular iterator)
+             *  
+             */
+            Iterator()
+                : mpSparseSets()
+                , mExclusion()
+                , mSince(0)
+                , mpEntity(nullptr)
+                , mpEnd(nullptr)
+                , mSparseIndices{}
+            {
+            }
+
+            /** 
+             * @brief  constructor, moves to the first entity having all of the Components
+             *  
+             * @param pSparseSets SparseSets of each Component
+             * @param exclusion SparseSets of the excluded Components
+             * @param since tick compared with by Added<T> and Changed<T>
+             * @param pEntity first entity of the pivot DenseEntities
+             * @param pEnd end of the pivot DenseEntities
+             */
+            Iterator(const std::tuple<SparseSetOf<ComponentType>*, SparseSetOf<OtherComponentTypes>*...>& pSparseSets, const Exclusion& exclusion, const Tick since, const Entity* const pEntity, const Entity* const pEnd)
+                : mpSparseSets(pSparseSets)
+                , mExclusion(exclusion)
+                , mSince(since)
+                , mpEntity(pEntity)
+                , mpEnd(pEnd)
+                , mSparseIndices{}
+            {
+                satisfy(kIndices);
+            }
+
+            reference operator*() const
+            {
+                return dereference(kIndices);
+            }
+
+            Iterator& operator++()
+            {
+                ++mpEntity;
+                satisfy(kIndices);
+                return *this;
+            }
+
+            Iterator operator++(int)
+            {
+                Iterator rtn = *this;
+                ++*this;
+                return rtn;
+            }
+
+            friend bool operator==(const Iterator& lhs, const Iterator& rhs)
+            {
+                return lhs.mpEntity == rhs.mpEntity;
+            }
+
+        private:
+            /** 
+             * @brief  advances to the first entity (from the current one) having all of the non-optional Components and none of the excluded ones
+             *  
+             */
+            template<std::size_t... I>
+            void satisfy(std::index_sequence<I...>)
+            {
+                for (; mpEntity != mpEnd; ++mpEntity)
+                {
+                    if ((findSparseIndex<TypeAt<I>>(*std::get<I>(mpSparseSets), *mpEntity, mSince, mSparseIndices[I]) && ...) && !mExclusion.excludes(*mpEntity))
+                    {
+                        return;
+                    }
+                }
+            }
+
+            /** 
+             * @brief  builds the tuple of the current entity and its Components
+             *  
+             */
+            template<std::size_t... I>
+            reference dereference(std::index_sequence<I...>) const
+            {
+                return reference(*mpEntity, getBySparseIndex<TypeAt<I>>(*std::get<I>(mpSparseSets), mSparseIndices[I], *mpEntity)...);
+            }
+
+            //! SparseSets of each Component
+            std::tuple<SparseSetOf<ComponentType>*, SparseSetOf<OtherComponentTypes>*...> mpSparseSets;
+            //! SparseSets of the excluded Components
+            Exclusion mExclusion;
+            //! tick compared with by Added<T> and Changed<T>
+            Tick mSince;
+            //! current entity in the pivot DenseEntities
+            const Entity* mpEntity;
+            //! end of the pivot DenseEntities
+            const Entity* mpEnd;
+            //! sparse indices of the current entity in each SparseSet
+            std::size_t mSparseIndices[kTypeNum];
+        };
 
         /** 
          * @brief constructor
@@ -30,17 +239,61 @@ namespace ec2s
          * @param head reference to SparseSet of the first ComponentType
          * @param tails reference to the SparseSet of the subsequent ComponentType
          */
-        View(SparseSet<ComponentType>& head, SparseSet<OtherComponentTypes>&... tails)
+        View(SparseSetOf<ComponentType>& head, SparseSetOf<OtherComponentTypes>&... tails)
             : mSparseSets(head, tails...)
+            , mSince(0)
         {}
 
+        /** 
+         * @brief constructor with excluded Component types
+         * @details user does not need to build this
+         * @param pExcludedSparseSets SparseSets of the Component types which the entities must not have (at most kMaxExcludedNum)
+         * @param head reference to SparseSet of the first ComponentType
+         * @param tails reference to the SparseSet of the subsequent ComponentType
+         */
+        View(std::initializer_list<const ISparseSet*> pExcludedSparseSets, SparseSetOf<ComponentType>& head, SparseSetOf<OtherComponentTypes>&... tails)
+            : mSparseSets(head, tails...)
+            , mSince(0)
+        {
+            assert(pExcludedSparseSets.size() <= kMaxExcludedNum || !"too many excluded Component types!");
+
+            for (const ISparseSet* pSparseSet : pExcludedSparseSets)
+            {
+                mExclusion.pSparseSets[mExclusion.num++] = pSparseSet;
+            }
+        }
+
+        /**
+         * @brief  set the tick compared with by Added<T> and Changed<T> (only the Components stamped after it pass, 0 by default)
+         * @details typically the tick returned by Registry::advanceTick() at the end of the previous run of the system
+         * @param tick last-run tick of the system
+         * @return reference to this View
+         */
+        View& since(const Tick tick) &
+        {
+            mSince = tick;
+            return *this;
+        }
+
+        /**
+         * @brief  set the tick compared with by Added<T> and Changed<T> on a temporary View
+         * @details returned by value, so that e.g. for (auto [e, t] : registry.view<Changed<T>>().since(tick)) does not refer to the destroyed temporary
+         * @param tick last-run tick of the system
+         * @return this View
+         */
+        View since(const Tick tick) &&
+        {
+            mSince = tick;
+            return std::move(*this);
+        }
+
         /**
-        * @brief returns the number of elements in the referenced SparseSet with the lowest number of elements
-         * @details i.e., each() is executed this many times
+        * @brief returns the number of elements in the referenced (non-optional) SparseSet with the lowest number of elements
+         * @details i.e., each() is executed at most this many times
          */
         std::size_t getMinSize() const
         {
-            return searchMinSize<OtherComponentTypes...>(std::get<0>(mSparseSets).size());
+            return searchMinSizeSparseSet(kIndices).size();
         }
 
         /**
@@ -52,7 +305,7 @@ namespace ec2s
         template<typename Func, typename Traits::IsEligibleEachFunc<Func, ComponentType, OtherComponentTypes...>* = nullptr>
         void each(Func func)
         {
-            invokeByMinSizeSparseSet<Func, 0, false, ComponentType, OtherComponentTypes...>(func, searchMinSizeSparseSet<OtherComponentTypes...>(std::get<0>(mSparseSets).size(), TypeHasher::hash<ComponentType>()));
+            invoke<false, ComponentType, OtherComponentTypes...>(func);
         }
 
         /**
@@ -64,7 +317,7 @@ namespace ec2s
         template<typename Func, typename Traits::IsEligibleEachFunc<Func, Entity, ComponentType, OtherComponentTypes...>* = nullptr>
         void each(Func func)
         {
-            invokeByMinSizeSparseSet<Func, 0, true, ComponentType, OtherComponentTypes...>(func, searchMinSizeSparseSet<OtherComponentTypes...>(std::get<0>(mSparseSets).size(), TypeHasher::hash<ComponentType>()));
+            invoke<true, ComponentType, OtherComponentTypes...>(func);
         }
 
         /** 
@@ -76,7 +329,7 @@ namespace ec2s
         template<typename TargetComponentType, typename... OtherTargetComponentTypes, typename Func, typename Traits::IsEligibleEachFunc<Func, TargetComponentType, OtherTargetComponentTypes...>* = nullptr>
         void each(Func func)
         {
-            invokeByMinSizeSparseSet<Func, 0, false, TargetComponentType, OtherTargetComponentTypes...>(func, searchMinSizeSparseSet<OtherComponentTypes...>(std::get<0>(mSparseSets).size(), TypeHasher::hash<ComponentType>()));
+            invoke<false, TargetComponentType, OtherTargetComponentTypes...>(func);
         }
 
         /**
@@ -90,95 +343,272 @@ namespace ec2s
         template<typename TargetComponentType, typename... OtherTargetComponentTypes, typename Func, typename Traits::IsEligibleEachFunc<Func, Entity, TargetComponentType, OtherTargetComponentTypes...>* = nullptr>
         void each(Func func)
         {
-            invokeByMinSizeSparseSet<Func, 0, true, TargetComponentType, OtherTargetComponentTypes...>(func, searchMinSizeSparseSet<OtherComponentTypes...>(std::get<0>(mSparseSets).size(), TypeHasher::hash<ComponentType>()));
+            invoke<true, TargetComponentType, OtherTargetComponentTypes...>(func);
+        }
+
+        /**
+         * @brief execute func on all referenced Components in parallel, splitting the DenseEntities of the smallest SparseSet into ranges of grainSize executed on the JobSystem (blocks until all finish)
+         * @details func is invoked concurrently from multiple threads, and the referenced SparseSets must not be modified meanwhile
+         * @tparam Func type of func (to be inferred), takes the referenced Components (optionally preceded by Entity)
+         * @param jobSystem JobSystem whose worker threads execute the ranges
+         * @param func function object to be executed, lambda expression, etc.
+         * @param grainSize maximum number of entities per job
+         */
+        template<typename Func>
+        void parallelEach(JobSystem& jobSystem, Func func, const std::size_t grainSize = JobSystem::kDefaultGrainSize)
+        {
+            constexpr bool withEntity = std::is_invocable_v<Func, Entity, Traits::ReferenceOf<ComponentType>, Traits::ReferenceOf<OtherComponentTypes>...>;
+            static_assert(withEntity || std::is_invocable_v<Func, Traits::ReferenceOf<ComponentType>, Traits::ReferenceOf<OtherComponentTypes>...>, "ineligible Func type!");
+
+            const std::pmr::vector<Entity>& entities = searchMinSizeSparseSet(kIndices).getDenseEntities();
+
+            jobSystem.parallelFor(entities.size(), grainSize,
+                [&](const std::size_t begin, const std::size_t end)
+                {
+                    invokeIfValidEntity<withEntity, ComponentType, OtherComponentTypes...>(func, std::span<const Entity>(entities).subspan(begin, end - begin));
+                });
+        }
+
+        /**
+         * @brief  iterator to the first entity having all of the Components
+         * @return iterator to the first entity
+         */
+        Iterator begin()
+        {
+            const std::pmr::vector<Entity>& entities = searchMinSizeSparseSet(kIndices).getDenseEntities();
+            return Iterator(getSparseSetPointers(), mExclusion, mSince, entities.data(), entities.data() + entities.size());
+        }
+
+        /**
+         * @brief  iterator past the last entity
+         * @return iterator past the last entity
+         */
+        Iterator end()
+        {
+            const std::pmr::vector<Entity>& entities = searchMinSizeSparseSet(kIndices).getDenseEntities();
+            return Iterator(getSparseSetPointers(), mExclusion, mSince, entities.data() + entities.size(), entities.data() + entities.size());
         }
 
     private:
 
         /**
-         * @brief  finds the smallest SparseSet in the mSparseSets tuple and returns its size
+         * @brief  returns pointers to the referenced SparseSets
          */
-        template<typename Head, typename... Tail>
-        std::size_t searchMinSize(const std::size_t nowMin) const 
+        std::tuple<SparseSetOf<ComponentType>*, SparseSetOf<OtherComponentTypes>*...> getSparseSetPointers() const
         {
-            return std::min(std::get<SparseSet<Head>&>(mSparseSets).size(), std::get<SparseSet<Tail>&>(mSparseSets).size()...);
+            return std::apply([](auto&... sparseSets) { return std::make_tuple(&sparseSets...); }, mSparseSets);
         }
 
         /**
-         * @brief  finds the minimum size SparseSet from the hash value and invokeIfValidEntity on its DenseEntities
+         * @brief  returns the minimum size SparseSet (the pivot whose DenseEntities are iterated)
+         * @details optional Component types never become the pivot, since the entities are not required to have them
          */
-        template<typename Head, typename... Tail>
-        TypeHash searchMinSizeSparseSet(const std::size_t nowMin, const TypeHash hash) const
+        template<std::size_t... I>
+        const ISparseSet& searchMinSizeSparseSet(std::index_sequence<I...>) const
         {
-            auto size = std::get<SparseSet<Head>&>(mSparseSets).size();
+            const ISparseSet* pPivot = nullptr;
 
-            if constexpr (sizeof...(Tail) > 0)
+            auto choose = [&pPivot](const ISparseSet& sparseSet, const bool optional)
             {
-                if (nowMin <= size)
+                if (!optional && (!pPivot || sparseSet.size() < pPivot->size()))
                 {
-                    return searchMinSizeSparseSet<Tail...>(nowMin, hash);
+                    pPivot = &sparseSet;
                 }
-                else
+            };
+
+            (choose(std::get<I>(mSparseSets), Traits::IsOptional<TypeAt<I>>), ...);
+
+            return *pPivot;
+        }
+
+        /**
+         * @brief  returns the position of the Component type T in this View
+         */
+        template<typename T>
+        constexpr static std::size_t indexOf()
+        {
+            constexpr bool matches[] = { std::is_same_v<T, ComponentType>, std::is_same_v<T, OtherComponentTypes>... };
+
+            for (std::size_t i = 0; i < kTypeNum; ++i)
+            {
+                if (matches[i])
                 {
-                    return searchMinSizeSparseSet<Tail...>(size, TypeHasher::hash<Head>());
+                    return i;
                 }
             }
-            else
-            {
-                return (nowMin <= size ? hash : TypeHasher::hash<Head>());
-            }
+
+            return kTypeNum;
         }
 
         /**
-         * @brief  find the minimum size SparseSet in the hash value and invokeIfValidEntity on its DenseEntities
+         * @brief  gets the sparse index of the entity in the SparseSet of the Component type T
+         * @details for Optional<T> it always succeeds, and kTombstone is stored if the entity does not have the Component \
+         *          for Added<T> and Changed<T> it also fails if the Component was not stamped after the tick since
+         * @return whether the entity can be passed to func
          */
-        template<typename Func, size_t SSIndex, bool withEntity, typename... ComponentTypes>
-        void invokeByMinSizeSparseSet(Func func, TypeHash hash)
+        template<typename T>
+        static bool findSparseIndex(SparseSetOf<T>& sparseSet, const Entity entity, const Tick since, std::size_t& sparseIndex_out)
         {
-            std::tuple targetTuple = std::tuple<SparseSet<ComponentTypes>&...>(std::get<SparseSet<ComponentTypes>&>(mSparseSets)...);
+            if constexpr (Traits::IsOptional<T>)
+            {
+                if (!sparseSet.contains(entity) || !sparseSet.getSparseIndexIfValid(entity, sparseIndex_out))
+                {
+                    sparseIndex_out = ISparseSet::kTombstone;
+                }
 
-            if constexpr (SSIndex < sizeof...(OtherComponentTypes) + 1)
+                return true;
+            }
+            else if constexpr (Traits::IsAdded<T> || Traits::IsChanged<T>)
             {
-                if (auto& sparseSet = std::get<SSIndex>(mSparseSets); hash == sparseSet.getPackedTypeHash())
+                static_assert(SparseSetOf<T>::kChangeTicks, "ticks are not kept for this Component type (Traits::ComponentTraits::kChangeTicks)!");
+
+                if (!sparseSet.getSparseIndexIfValid(entity, sparseIndex_out))
                 {
-                    invokeIfValidEntity<withEntity>(func, sparseSet.getDenseEntities(), targetTuple, std::index_sequence_for<ComponentTypes...>()); 
+                    return false;
+                }
+
+                if constexpr (Traits::IsAdded<T>)
+                {
+                    return sparseSet.getAddedTickBySparseIndex(sparseIndex_out) > since;
                 }
                 else
                 {
-                    invokeByMinSizeSparseSet<Func, SSIndex + 1, withEntity, ComponentTypes...>(func, hash);
+                    return sparseSet.getChangedTickBySparseIndex(sparseIndex_out) > since;
                 }
             }
+            else
+            {
+                return sparseSet.getSparseIndexIfValid(entity, sparseIndex_out);
+            }
+        }
+
+        /**
+         * @brief  gets the argument for the Component type T from the sparse index found by findSparseIndex (nullptr for an absent optional Component)
+         * @details read-only Component types are accessed through the const SparseSet, so that their changed ticks are not stamped
+         */
+        template<typename T>
+        static Traits::ReferenceOf<T> getBySparseIndex(SparseSetOf<T>& sparseSet, const std::size_t sparseIndex, const Entity entity)
+        {
+            std::conditional_t<Traits::IsReadOnly<T>, const SparseSetOf<T>, SparseSetOf<T>>& accessed = sparseSet;
+
+            if constexpr (Traits::IsOptional<T>)
+            {
+                return sparseIndex == ISparseSet::kTombstone ? nullptr : &accessed.getBySparseIndex(sparseIndex, entity);
+            }
+            else
+            {
+                return accessed.getBySparseIndex(sparseIndex, entity);
+            }
+        }
+
+        /**
+         * @brief  gets the sparse indices of the entity in every referenced SparseSet
+         * @return whether the entity has all of the non-optional Components
+         */
+        template<std::size_t... I>
+        bool findSparseIndices(const Entity entity, std::size_t (&sparseIndices)[kTypeNum], std::index_sequence<I...>) const
+        {
+            return (findSparseIndex<TypeAt<I>>(std::get<I>(mSparseSets), entity, mSince, sparseIndices[I]) && ...);
+        }
+
+        /**
+         * @brief  executes func with the specified TargetTypes for all of the entities in the View, by the membership bitsets if possible
+         */
+        template<bool withEntity, typename... TargetTypes, typename Func>
+        void invoke(Func func)
+        {
+            if constexpr (kUseMembership)
+            {
+                invokeByMembership<withEntity, TargetTypes...>(func, kIndices);
+            }
+            else
+            {
+                invokeIfValidEntity<withEntity, TargetTypes...>(func, searchMinSizeSparseSet(kIndices).getDenseEntities());
+            }
         }
 
         /**
-         * @brief  for each specified SparseSet, executes func with the entities that were valid in all of the entities
+         * @brief  for each of the entities having all of the non-optional Components, executes func with the specified TargetTypes
+         * @details all state is local to the call, so the same View type can be iterated from multiple threads at once
          */
-        template<bool withEntity, typename T, T... I, typename Func, typename Tuple>
-        void invokeIfValidEntity(Func func, const std::vector<Entity>& entities, Tuple& tuple, std::integer_sequence<T, I...>)
+        template<bool withEntity, typename... TargetTypes, typename Func>
+        void invokeIfValidEntity(Func func, std::span<const Entity> entities)
         {
-            static std::size_t sparseIndices[sizeof...(I)] = { 0 };
+            std::size_t sparseIndices[kTypeNum] = {};
 
             for (const auto& entity : entities)
             {
-                if (!(std::get<I>(tuple).getSparseIndexIfValid(entity, sparseIndices[I]) & ...))
-                {
-                    continue;
-                }
+                invokeIfValid<withEntity, TargetTypes...>(func, entity, sparseIndices);
+            }
+        }
+
+        /**
+         * @brief  executes func with the specified TargetTypes for the entity indices set in the membership bitsets of all the non-optional SparseSets
+         * @details whole blocks of 4096 and 64 entity indices without matches are skipped before any SparseSet is probed \
+         *          and the excluded SparseSets maintaining a membership bitset are subtracted word by word
+         */
+        template<bool withEntity, typename... TargetTypes, typename Func, std::size_t... I>
+        void invokeByMembership(Func func, std::index_sequence<I...>)
+        {
+            std::array<const HierarchicalBitset*, kTypeNum> pIncluded{};
+            std::size_t includedNum = 0;
+            ((Traits::IsOptional<TypeAt<I>> ? void() : void(pIncluded[includedNum++] = std::get<I>(mSparseSets).getMembership())), ...);
 
-                if constexpr (withEntity)
+            std::array<const HierarchicalBitset*, Exclusion::kMaxNum> pExcluded{};
+            std::size_t excludedNum = 0;
+            for (std::size_t i = 0; i < mExclusion.num; ++i)
+            {
+                if (const HierarchicalBitset* const pMembership = mExclusion.pSparseSets[i]->getMembership())
                 {
-                    func(entity, std::get<I>(tuple).getBySparseIndex(sparseIndices[I], entity)...);
+                    pExcluded[excludedNum++] = pMembership;
                 }
-                else
+            }
+
+            // any of the non-optional SparseSets restores the generation of the entity index
+            const ISparseSet& pivot             = searchMinSizeSparseSet(kIndices);
+            std::size_t sparseIndices[kTypeNum] = {};
+
+            HierarchicalBitset::intersect(std::span(pIncluded.data(), includedNum), std::span(pExcluded.data(), excludedNum),
+                [&](const std::size_t index)
                 {
-                    func(std::get<I>(tuple).getBySparseIndex(sparseIndices[I], entity)...);
-                }
+                    invokeIfValid<withEntity, TargetTypes...>(func, pivot.getEntityByIndex(index), sparseIndices);
+                });
+        }
+
+        /**
+         * @brief  executes func with the specified TargetTypes if the entity has all of the non-optional Components and none of the excluded ones
+         */
+        template<bool withEntity, typename... TargetTypes, typename Func>
+        void invokeIfValid(Func& func, const Entity entity, std::size_t (&sparseIndices)[kTypeNum])
+        {
+            static_assert(((indexOf<TargetTypes>() < kTypeNum) && ...), "the Component type is not referred to by this View!");
+
+            if (!findSparseIndices(entity, sparseIndices, kIndices) || mExclusion.excludes(entity))
+            {
+                return;
+            }
+
+            if constexpr (withEntity)
+            {
+                func(entity, getBySparseIndex<TargetTypes>(std::get<indexOf<TargetTypes>()>(mSparseSets), sparseIndices[indexOf<TargetTypes>()], entity)...);
+            }
+            else
+            {
+                func(getBySparseIndex<TargetTypes>(std::get<indexOf<TargetTypes>()>(mSparseSets), sparseIndices[indexOf<TargetTypes>()], entity)...);
             }
         }
 
         //! tuple of all View configuration components
-        std::tuple<SparseSet<ComponentType>&, SparseSet<OtherComponentTypes>&...> mSparseSets;
+        std::tuple<SparseSetOf<ComponentType>&, SparseSetOf<OtherComponentTypes>&...> mSparseSets;
+        //! SparseSets of the excluded Component types
+        Exclusion mExclusion;
+        //! tick compared with by Added<T> and Changed<T>
+        Tick mSince;
     };
 }
 
+//! iterators of View refer to the SparseSets, not to the View, so they can outlive a temporary View
+template<typename ComponentType, typename... OtherComponentTypes>
+inline constexpr bool std::ranges::enable_borrowed_range<ec2s::View<ComponentType, OtherComponentTypes...>> = true;
+
 #endif
\ No newline at end of file
@@ -358,5 +358,60 @@ void test()
         std::cout << "time : " << elapsed << "[ms]\n";
     }
 
+    entities.clear();
+    entities.resize(kTestEntityNum);
+    std::cout << "\n\nbulk insert-----------------\n\n";
+
+    {
+        std::cout << "create and insert : \n";
+        start = std::chrono::high_resolution_clock::now();
+
+        // same composition of component as "create and emplace"
+        std::vector<ec2s::Entity> oddEntities, evenEntities;
+        oddEntities.reserve(kTestEntityNum / 2);
+        evenEntities.reserve(kTestEntityNum / 2);
+
+        for (std::size_t i = 0; i < kTestEntityNum; ++i)
+        {
+            entities[i] = registry.create();
+            (i % 2 ? oddEntities : evenEntities).emplace_back(entities[i]);
+        }
+
+        registry.insert<A>(entities.begin(), entities.end(), A(1));
+        registry.insert<B>(oddEntities.begin(), oddEntities.end(), B(0.3));
+        registry.insert<C>(evenEntities.begin(), evenEntities.end(), C('a'));
+
+        end = std::chrono::high_resolution_clock::now();
+        elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()); 
+        std::cout << "time : " << elapsed << "[ms]\n\n";
+    }
+
+    {
+        std::cout << "check : ";
+        bool succeeded = registry.size<A>() == kTestEntityNum && registry.size<B>() == kTestEntityNum / 2 && registry.size<C>() == kTestEntityNum / 2;
+
+        registry.each<A>([&](A e) {if (e.a != 1)   succeeded = false; });
+        registry.each<B>([&](B e) {if (e.b != 0.3) succeeded = false; });
+        registry.each<C>([&](C e) {if (e.c != 'a') succeeded = false; });
+        if (succeeded)
+        {
+            std::cout << "OK\n\n";
+        }
+        else
+        {
+            std::cout << "NG\n\n";
+        }
+    }
+
+    {
+        std::cout << "destroy (batch) : \n";
+        start = std::chrono::high_resolution_clock::now();
+        registry.destroy(entities.begin(), entities.end());
+
+        end = std::chrono::high_resolution_clock::now();
+        elapsed = static_cast<double>(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count()); 
+        std::cout << "time : " << elapsed << "[ms]\n";
+    }
+
     std::cout << "all test end successfully----------------\n";
 }